@@ -2,9 +2,16 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <iterator>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include "exchange.h"
 #include "price_feed.h"
+#include "change_set.h"
+#include "thread_pool.h"
+#include "price_kernels.h"
 #include "latency_calculator.h"
 #include "network_graph.h"
 
@@ -12,32 +19,44 @@
  * Represents a single arbitrage opportunity
  */
 struct ArbitrageOpportunity {
+    std::string symbol;            // What to trade
     std::string buy_exchange;      // Where to buy
     std::string sell_exchange;     // Where to sell
-    double buy_price;              // Purchase price (ask)
-    double sell_price;             // Sale price (bid)
-    double price_diff;             // Absolute price difference
+    Ticks buy_ticks;               // Purchase price (ask)
+    Ticks sell_ticks;              // Sale price (bid)
+    double tick_size;              // Price of one tick of the symbol
     double profit_percent;         // Profit percentage (before fees)
     double latency_ms;             // One-way network latency
     double rtt_ms;                 // Round-trip time
     double estimated_profit;       // Net profit after fees
+    double executable_size;        // Units fillable at a profit against book depth (0 = no books)
+    double depth_profit;           // Net profit of filling executable_size through the books
     double opportunity_window_ms;  // How long opportunity lasts
     bool is_executable;            // Can we execute in time?
-    uint64_t timestamp;            // When opportunity was detected
+    uint64_t timestamp;            // Buy-side quote time, ns since epoch
     
     // For ranking
     double score;                  // Overall opportunity score
     
     ArbitrageOpportunity() : 
-        buy_price(0), sell_price(0), price_diff(0), profit_percent(0),
-        latency_ms(0), rtt_ms(0), estimated_profit(0), opportunity_window_ms(0),
+        buy_ticks(0), sell_ticks(0), tick_size(0), profit_percent(0),
+        latency_ms(0), rtt_ms(0), estimated_profit(0), executable_size(0), depth_profit(0),
+        opportunity_window_ms(0),
         is_executable(false), timestamp(0), score(0) {}
+    
+    // Prices in currency units
+    double buy_price() const { return static_cast<double>(buy_ticks) * tick_size; }
+    double sell_price() const { return static_cast<double>(sell_ticks) * tick_size; }
+    double price_diff() const { return static_cast<double>(sell_ticks - buy_ticks) * tick_size; }
 };
 
 /**
  * Arbitrage Scanner - Detects and ranks trading opportunities
  */
 class ArbitrageScanner {
+public:
+    using OpportunityList = std::shared_ptr<const std::vector<ArbitrageOpportunity>>;
+    
 private:
     const NetworkGraph& network;
     const PriceFeed& price_feed;
@@ -48,6 +67,77 @@ private:
     double slippage_percent = 0.05;        // 0.05% slippage
     double avg_opportunity_window_ms = 200.0; // Average window duration
     TransmissionMedium medium = TransmissionMedium::FIBER_OPTIC;
+    std::string observer_id;               // Empty = every quote seen instantly
+    bool size_with_books = false;          // This scan sizes against live L2 depth
+    
+    // Per-scan view of one symbol row (indexed by venue handle, prices in ticks)
+    struct RowView {
+        const Ticks* bid;
+        const Ticks* ask;
+        const uint64_t* ts;
+    };
+    std::vector<Ticks> observed_bid;       // Symbol x venue matrices of the observer's delayed view
+    std::vector<Ticks> observed_ask;
+    std::vector<uint64_t> observed_ts;
+    std::vector<uint64_t> observed_as_of;  // Per venue handle: now - latency from the observer (ns)
+    
+    // Incremental scans keep their ranked result between calls, each entry
+    // tagged with its pair so a rescan can drop exactly the stale ones
+    struct PairKey {
+        uint32_t symbol;
+        uint32_t buy;                      // Exchange indices
+        uint32_t sell;
+    };
+    struct PairOpportunity {
+        PairKey key;
+        ArbitrageOpportunity opp;
+    };
+    std::shared_ptr<std::vector<ArbitrageOpportunity>> ranked;   // Handed out as OpportunityList
+    std::vector<PairKey> ranked_keys;      // Parallel to *ranked
+    std::vector<int> table_handles;        // Handles the table was computed with (masked = -1)
+    std::vector<int> exchange_of_venue;    // Venue handle -> exchange index (-1 = not in the network)
+    std::vector<uint8_t> exchange_dirty;   // Per exchange: row being rescanned
+    std::vector<uint32_t> dirty_exchanges;
+    std::vector<uint8_t> cell_dirty;       // Symbol x exchange: rescanned this scan
+    std::vector<size_t> dirty_cells;
+    size_t table_symbols = 0;
+    bool table_valid = false;
+    bool table_books = false;
+    uint64_t config_version = 0;           // Bumped by every setting that changes results
+    uint64_t table_version = 0;
+    size_t pairs_evaluated = 0;            // Buy/sell directions screened, last scan
+    
+    bool sorted_crosses = true;
+    using VenueQuote = std::pair<Ticks, uint32_t>;   // (price, exchange index)
+    
+    // Output and scratch of one chunk of a scan; chunks run on their own
+    // thread and are merged in chunk order, so results never depend on timing
+    struct ScanBuffer {
+        std::vector<ArbitrageOpportunity> opportunities;
+        std::vector<PairOpportunity> found;   // Incremental scans: opportunities with their pair
+        std::vector<VenueQuote> by_ask;    // Sorted-cross scans: visible venues by price
+        std::vector<VenueQuote> by_bid;
+        std::vector<double> tile_bid;      // Pair scans: row tile then column tile, as doubles
+        std::vector<double> tile_ask;
+        std::vector<double> margin;        // screen_sells() output
+        size_t pairs = 0;
+    };
+    std::vector<ScanBuffer> buffers;       // Per chunk
+    ScanBuffer serial;                     // Incremental rescans
+    std::unique_ptr<ThreadPool> workers;   // Null = single-threaded scans
+    
+    // Pair scans walk the upper triangle of venue pairs in square tiles;
+    // two tiles' quotes and handles (~10 KB) stay in L1 while they are compared
+    static constexpr size_t TILE_VENUES = 256;
+    std::vector<std::pair<uint32_t, uint32_t>> tile_pairs;   // (row tile, column tile), column >= row
+    
+    // Last shared result and the state it was scanned from
+    OpportunityList cached;
+    uint64_t cached_epoch = 0;             // PriceFeed::get_epoch()
+    uint64_t cached_version = 0;           // config_version
+    uint64_t cached_clock = 0;             // observer_clock()
+    uint64_t view_time_ns = 0;             // Observer views as of this feed time (0 = now)
+    bool cached_incremental = false;       // Incremental table is up to date with it
     
 public:
     ArbitrageScanner(const NetworkGraph& net, const PriceFeed& feed)
@@ -57,73 +147,363 @@ public:
      * Scan for all arbitrage opportunities
      */
     std::vector<ArbitrageOpportunity> scan_opportunities() {
+        const auto& quotes = price_feed.get_quotes();
+        
+        std::vector<int> handles = resolve_handles();
+        bool use_matrix = network.has_latency_matrix();
+        bool observed = prepare_observer_view(handles, use_matrix);
+        size_with_books = price_feed.has_order_books() && !observed; // Books are live-only
+        
+        // Work items: one per symbol when sorting crosses, else one per
+        // (symbol, tile pair), each over the symbol's contiguous venue row
+        size_t per_symbol = 1;
+        if (!sorted_crosses) {
+            build_tile_pairs(handles.size());
+            per_symbol = tile_pairs.size();
+        }
+        run_chunks(quotes.num_symbols * per_symbol, [&](ScanBuffer& buf, size_t item) {
+            int symbol = static_cast<int>(item / per_symbol);
+            RowView view = observed ? observed_row(symbol) : live_row(symbol);
+            auto emit = [&buf](ArbitrageOpportunity& opp, size_t, size_t) {
+                buf.opportunities.push_back(std::move(opp));
+            };
+            if (sorted_crosses) scan_crosses(symbol, view, handles, use_matrix, buf, emit);
+            else scan_tile(symbol, view, handles, use_matrix, tile_pairs[item % per_symbol], buf, emit);
+        });
+        
+        size_t total = 0;
+        pairs_evaluated = 0;
+        for (const auto& buf : buffers) {
+            total += buf.opportunities.size();
+            pairs_evaluated += buf.pairs;
+        }
         std::vector<ArbitrageOpportunity> opportunities;
+        opportunities.reserve(total);
+        for (auto& buf : buffers) {
+            std::move(buf.opportunities.begin(), buf.opportunities.end(), std::back_inserter(opportunities));
+        }
+        
+        rank(opportunities);
+        return opportunities;
+    }
+    
+    /**
+     * Incremental scan: re-evaluate only the pairs of venues whose quotes changed
+     * `changed` must hold every cell changed since the previous incremental
+     * scan (e.g. PriceFeed::get_changes() when the caller clears it after
+     * each scan). The ranked result persists between calls: a tick that
+     * moves c of N venues costs O(c x N) pair tests, and only the dropped
+     * and rescanned pairs are spliced into the list (it is copied first
+     * only while a caller still holds the previous one).
+     * Rebuilds everything on the first call and after a setting, universe or
+     * venue mask change; with an observer set it is a full scan (delayed
+     * views age with time).
+     */
+    OpportunityList scan_opportunities(const ChangeSet& changed) {
         const auto& exchanges = network.get_exchanges();
-        const auto& prices = price_feed.get_all_prices();
+        const auto& quotes = price_feed.get_quotes();
         
-        // Compare every pair of exchanges
-        for (size_t i = 0; i < exchanges.size(); i++) {
-            for (size_t j = i + 1; j < exchanges.size(); j++) {
-                const auto& ex1 = exchanges[i];
-                const auto& ex2 = exchanges[j];
-                
-                // Get prices
-                auto price1_it = prices.find(ex1.id);
-                auto price2_it = prices.find(ex2.id);
-                
-                if (price1_it == prices.end() || price2_it == prices.end()) {
-                    continue;
-                }
-                
-                const auto& quote1 = price1_it->second;
-                const auto& quote2 = price2_it->second;
-                
-                // Check both directions
-                // Direction 1: Buy at ex1, sell at ex2
-                auto opp1 = evaluate_opportunity(ex1, ex2, quote1, quote2);
-                if (opp1.is_executable && opp1.estimated_profit > 0) {
-                    opportunities.push_back(opp1);
-                }
-                
-                // Direction 2: Buy at ex2, sell at ex1
-                auto opp2 = evaluate_opportunity(ex2, ex1, quote2, quote1);
-                if (opp2.is_executable && opp2.estimated_profit > 0) {
-                    opportunities.push_back(opp2);
-                }
+        std::vector<int> handles = resolve_handles();
+        bool use_matrix = network.has_latency_matrix();
+        if (prepare_observer_view(handles, use_matrix)) {
+            table_valid = false;
+            return std::make_shared<const std::vector<ArbitrageOpportunity>>(scan_opportunities());
+        }
+        size_with_books = price_feed.has_order_books();
+        serial.pairs = 0;
+        serial.found.clear();
+        
+        bool rebuild = !table_valid || table_version != config_version || table_books != size_with_books ||
+                       table_symbols != quotes.num_symbols || table_handles.size() != handles.size() ||
+                       changed.symbol_count() != quotes.num_symbols || changed.venue_count() != quotes.num_venues;
+        if (rebuild) {
+            // Symbols in parallel, each chunk collecting its own pairs
+            if (!ranked || ranked.use_count() > 1) ranked = std::make_shared<std::vector<ArbitrageOpportunity>>();
+            ranked->clear();
+            ranked_keys.clear();
+            dirty_cells.clear();
+            exchange_dirty.assign(exchanges.size(), 0);
+            cell_dirty.assign(quotes.num_symbols * exchanges.size(), 0);
+            if (!sorted_crosses) build_tile_pairs(handles.size());
+            run_chunks(quotes.num_symbols, [&](ScanBuffer& buf, size_t s) {
+                uint32_t symbol = static_cast<uint32_t>(s);
+                scan_symbol(static_cast<int>(s), live_row(static_cast<int>(s)), handles, use_matrix, buf,
+                            [&buf, symbol](ArbitrageOpportunity& opp, size_t buy, size_t sell) {
+                                buf.found.push_back(PairOpportunity{ { symbol, static_cast<uint32_t>(buy), static_cast<uint32_t>(sell) }, std::move(opp) });
+                            });
+            });
+            for (auto& buf : buffers) {
+                serial.pairs += buf.pairs;
+                std::move(buf.found.begin(), buf.found.end(), std::back_inserter(serial.found));
+            }
+        } else {
+            // A venue masked or unmasked since the last scan is dirty in every row
+            std::vector<uint32_t> remasked;
+            for (size_t i = 0; i < handles.size(); i++) {
+                if (handles[i] != table_handles[i]) remasked.push_back(static_cast<uint32_t>(i));
+            }
+            for (size_t s = 0; s < quotes.num_symbols; s++) {
+                if (remasked.empty() && !changed.symbol_changed(s)) continue;
+                for (uint32_t i : remasked) mark_dirty(i);
+                changed.for_each_venue(s, [this](size_t v) {
+                    if (exchange_of_venue[v] >= 0) mark_dirty(static_cast<uint32_t>(exchange_of_venue[v]));
+                });
+                if (!dirty_exchanges.empty()) rescan_dirty(static_cast<int>(s), handles, use_matrix);
             }
         }
+        pairs_evaluated = serial.pairs;
+        table_handles = std::move(handles);
+        table_valid = true;
+        table_version = config_version;
+        table_books = size_with_books;
+        table_symbols = quotes.num_symbols;
         
-        // Rank opportunities by score
-        std::sort(opportunities.begin(), opportunities.end(),
-                 [](const ArbitrageOpportunity& a, const ArbitrageOpportunity& b) {
-                     return a.score > b.score;
-                 });
+        if (!dirty_cells.empty() || !serial.found.empty()) splice_found();
+        return ranked;
+    }
+    
+    /**
+     * Make the next incremental scan a full rebuild (e.g. after the
+     * network's latencies changed, which no ChangeSet records)
+     */
+    void invalidate() {
+        table_valid = false;
+        cached.reset();
+        ranked.reset();
+    }
+    
+    /**
+     * Ranked opportunities for the feed as it stands, scanned at most once
+     * per feed epoch and settings version; every caller until the next
+     * change shares the same immutable list
+     * With an observer the delayed view also ages with the clock, so it is
+     * rescanned once per history bucket of the view time (pin it with
+     * set_view_time() to share one scan between callers). A list stays
+     * valid for as long as it is held, even after a newer scan replaces it.
+     */
+    OpportunityList latest_opportunities() { return latest(nullptr); }
+    
+    /**
+     * As latest_opportunities(), running an incremental scan on a miss
+     * (`changed` as for scan_opportunities(const ChangeSet&); the caller
+     * may clear it after every call, hit or miss)
+     */
+    OpportunityList latest_opportunities(const ChangeSet& changed) { return latest(&changed); }
+    
+    /**
+     * Scan one symbol for crossed venue pairs
+     * Venues whose quote is not visible or not yet quoted (NO_PRICE) are
+     * skipped, as are directions with no gross edge (an exact integer
+     * compare, before any opportunity is built). By default only crossing
+     * directions are enumerated (see set_sorted_crosses()); otherwise every
+     * pair is compared.
+     */
+    void scan_symbol(int symbol, const RowView& view, const std::vector<int>& handles, bool use_matrix,
+                     std::vector<ArbitrageOpportunity>& opportunities) {
+        if (!sorted_crosses) build_tile_pairs(handles.size());
+        scan_symbol(symbol, view, handles, use_matrix, serial, [&opportunities](ArbitrageOpportunity& opp, size_t, size_t) {
+            opportunities.push_back(std::move(opp));
+        });
+    }
+    
+    /**
+     * scan_symbol() handing each opportunity to fn(opp, buy_index, sell_index)
+     * (exchange indices), with `buf` as scratch (pair scans need
+     * build_tile_pairs() first; this may run on several threads at once)
+     */
+    template <typename Fn>
+    void scan_symbol(int symbol, const RowView& view, const std::vector<int>& handles, bool use_matrix,
+                     ScanBuffer& buf, Fn&& fn) {
+        if (sorted_crosses) {
+            scan_crosses(symbol, view, handles, use_matrix, buf, fn);
+            return;
+        }
+        for (const auto& tiles : tile_pairs) scan_tile(symbol, view, handles, use_matrix, tiles, buf, fn);
+    }
+    
+    /**
+     * Compare every pair of venues with one in the row tile and the other
+     * in the column tile, in both directions
+     * Each tile's quotes are gathered into contiguous doubles once; then
+     * every buy venue is screened against the other tile's bids and
+     * latencies by a vectorized kernel, and opportunity records are built
+     * only for the directions that survive.
+     */
+    template <typename Fn>
+    void scan_tile(int symbol, const RowView& view, const std::vector<int>& handles, bool use_matrix,
+                   std::pair<uint32_t, uint32_t> tiles, ScanBuffer& buf, Fn& fn) {
+        const SymbolSpec& spec = price_feed.get_symbol(symbol);
+        buf.tile_bid.resize(2 * TILE_VENUES);
+        buf.tile_ask.resize(2 * TILE_VENUES);
+        buf.margin.resize(TILE_VENUES);
+        double* row_bid = buf.tile_bid.data();
+        double* row_ask = buf.tile_ask.data();
+        double* column_bid = row_bid + TILE_VENUES;
+        double* column_ask = row_ask + TILE_VENUES;
+        size_t row_begin = tiles.first * TILE_VENUES;
+        size_t column_begin = tiles.second * TILE_VENUES;
+        size_t rows = gather_tile(view, handles, row_begin, row_bid, row_ask);
+        size_t columns = gather_tile(view, handles, column_begin, column_bid, column_ask);
         
-        return opportunities;
+        screen_tile(symbol, spec, view, handles, use_matrix, row_begin, rows, row_ask,
+                    column_begin, columns, column_bid, buf, fn);
+        if (tiles.first != tiles.second) {
+            screen_tile(symbol, spec, view, handles, use_matrix, column_begin, columns, column_ask,
+                        row_begin, rows, row_bid, buf, fn);
+        }
+    }
+    
+    /**
+     * Buy at each of `buys` venues from buy_begin, sell at each of `sells`
+     * venues from sell_begin (tile-local prices from gather_tile())
+     */
+    template <typename Fn>
+    void screen_tile(int symbol, const SymbolSpec& spec, const RowView& view, const std::vector<int>& handles,
+                     bool use_matrix, size_t buy_begin, size_t buys, const double* buy_ask,
+                     size_t sell_begin, size_t sells, const double* sell_bid, ScanBuffer& buf, Fn& fn) {
+        double hurdle = profit_hurdle();
+        double* margin = buf.margin.data();
+        for (size_t b = 0; b < buys; b++) {
+            if (!std::isfinite(buy_ask[b])) continue;
+            size_t buy = buy_begin + b;
+            double min_bid = std::max(buy_ask[b], buy_ask[b] * hurdle);
+            const double* latency = use_matrix ? network.latency_row(static_cast<int>(buy)) + sell_begin : nullptr;
+            PriceKernels::screen_sells(min_bid, sell_bid, latency, avg_opportunity_window_ms, sells, margin);
+            buf.pairs += sells;
+            
+            for (size_t k = 0; k < sells; k++) {
+                if (!(margin[k] > 0.0)) continue;
+                size_t sell = sell_begin + k;
+                if (sell == buy) continue;
+                scan_direction(symbol, spec, view, buy, sell, handles[buy], handles[sell], use_matrix, fn);
+            }
+        }
+    }
+    
+    /**
+     * Enumerate only the crossing directions of one symbol
+     * Visible venues are sorted by ask (ascending) and by bid (descending).
+     * For each sell venue the buy venues that can clear the profit hurdle
+     * are a prefix of the ask order, and that prefix shrinks as the bid
+     * falls, so the scan stops at the first sell venue with an empty
+     * prefix: O(N log N + K) for K crossing directions.
+     */
+    template <typename Fn>
+    void scan_crosses(int symbol, const RowView& view, const std::vector<int>& handles, bool use_matrix,
+                      ScanBuffer& buf, Fn& fn) {
+        auto& by_ask = buf.by_ask;
+        auto& by_bid = buf.by_bid;
+        by_ask.clear();
+        by_bid.clear();
+        for (size_t i = 0; i < handles.size(); i++) {
+            int v = handles[i];
+            if (!visible(view, v)) continue;
+            by_ask.emplace_back(view.ask[v], static_cast<uint32_t>(i));
+            by_bid.emplace_back(view.bid[v], static_cast<uint32_t>(i));
+        }
+        if (by_ask.size() < 2) return;
+        std::sort(by_ask.begin(), by_ask.end());
+        std::sort(by_bid.begin(), by_bid.end(), [](const VenueQuote& a, const VenueQuote& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+        
+        double hurdle = profit_hurdle();
+        
+        const SymbolSpec& spec = price_feed.get_symbol(symbol);
+        for (const VenueQuote& sell : by_bid) {
+            Ticks sell_bid = sell.first;
+            double max_ask = static_cast<double>(sell_bid) / hurdle;
+            if (by_ask[0].first >= sell_bid || static_cast<double>(by_ask[0].first) > max_ask) break;
+            
+            for (const VenueQuote& buy : by_ask) {
+                if (buy.first >= sell_bid || static_cast<double>(buy.first) > max_ask) break;
+                if (buy.second == sell.second) continue;
+                buf.pairs++;
+                scan_direction(symbol, spec, view, buy.second, sell.second,
+                               handles[buy.second], handles[sell.second], use_matrix, fn);
+            }
+        }
+    }
+    
+    /**
+     * Compare both directions of exchanges i < j (venue handles v1, v2,
+     * both visible)
+     */
+    template <typename Fn>
+    void scan_pair(int symbol, const SymbolSpec& spec, const RowView& view, size_t i, size_t j, int v1, int v2,
+                   bool use_matrix, ScanBuffer& buf, Fn& fn) {
+        const Ticks* bid = view.bid;
+        const Ticks* ask = view.ask;
+        buf.pairs += 2;
+        
+        // Check both directions
+        // Direction 1: Buy at ex1, sell at ex2
+        if (bid[v2] > ask[v1]) scan_direction(symbol, spec, view, i, j, v1, v2, use_matrix, fn);
+        
+        // Direction 2: Buy at ex2, sell at ex1
+        if (bid[v1] > ask[v2]) scan_direction(symbol, spec, view, j, i, v2, v1, use_matrix, fn);
+    }
+    
+    /**
+     * Evaluate buying at exchange `buy` and selling at exchange `sell`
+     * (venue handles buy_venue, sell_venue) and hand a profitable,
+     * executable opportunity to fn
+     * Directions that cannot clear the profit hurdle or the window are
+     * dropped by two scalar compares before evaluate_opportunity().
+     */
+    template <typename Fn>
+    void scan_direction(int symbol, const SymbolSpec& spec, const RowView& view, size_t buy, size_t sell,
+                        int buy_venue, int sell_venue, bool use_matrix, Fn& fn) {
+        const auto& exchanges = network.get_exchanges();
+        const auto& buy_ex = exchanges[buy];
+        const auto& sell_ex = exchanges[sell];
+        Ticks buy_ask = view.ask[buy_venue];
+        Ticks sell_bid = view.bid[sell_venue];
+        if (static_cast<double>(sell_bid) < static_cast<double>(buy_ask) * profit_hurdle()) return;
+        double latency = use_matrix ? network.latency_between(buy, sell)
+                                    : network.shortest_path_latency(buy_ex.id, sell_ex.id);
+        if (!(latency * 2.0 < avg_opportunity_window_ms)) return;
+        
+        // Only now build the record (two string copies) and score it
+        auto opp = evaluate_opportunity(buy_ex, sell_ex, buy_ask, sell_bid, spec.tick_size,
+                                        view.ts[buy_venue], latency);
+        if (opp.is_executable && opp.estimated_profit > 0) {
+            opp.symbol = spec.name;
+            if (size_with_books) size_against_depth(opp, symbol, buy_venue, sell_venue);
+            fn(opp, buy, sell);
+        }
     }
     
     /**
      * Evaluate a single arbitrage opportunity
+     * @param buy_ask Ask at the buy venue, in ticks (we pay the ask)
+     * @param sell_bid Bid at the sell venue, in ticks (we receive the bid)
+     * @param tick_size Price of one tick of the symbol
+     * @param latency_ms One-way network latency buy -> sell
      */
     ArbitrageOpportunity evaluate_opportunity(
         const Exchange& buy_ex, 
         const Exchange& sell_ex,
-        const PriceQuote& buy_quote,
-        const PriceQuote& sell_quote) {
+        Ticks buy_ask,
+        Ticks sell_bid,
+        double tick_size,
+        uint64_t timestamp,
+        double latency_ms) {
         
         ArbitrageOpportunity opp;
         opp.buy_exchange = buy_ex.id;
         opp.sell_exchange = sell_ex.id;
-        opp.buy_price = buy_quote.ask;  // We pay the ask price
-        opp.sell_price = sell_quote.bid; // We receive the bid price
-        opp.timestamp = buy_quote.timestamp;
+        opp.buy_ticks = buy_ask;
+        opp.sell_ticks = sell_bid;
+        opp.tick_size = tick_size;
+        opp.timestamp = timestamp;
         
-        // Calculate price difference
-        opp.price_diff = opp.sell_price - opp.buy_price;
-        opp.profit_percent = (opp.price_diff / opp.buy_price) * 100.0;
+        // Calculate price difference (exact in ticks; the tick size cancels in the ratio)
+        double buy_price = opp.buy_price();
+        opp.profit_percent = static_cast<double>(sell_bid - buy_ask) / static_cast<double>(buy_ask) * 100.0;
         
         // Calculate network latency
-        opp.latency_ms = network.shortest_path_latency(buy_ex.id, sell_ex.id);
+        opp.latency_ms = latency_ms;
         opp.rtt_ms = opp.latency_ms * 2.0;
         
         // Estimate opportunity window (how long price discrepancy lasts)
@@ -133,9 +513,9 @@ public:
         opp.is_executable = (opp.rtt_ms < opp.opportunity_window_ms);
         
         // Calculate net profit after fees and slippage
-        double gross_profit = opp.price_diff;
-        double trading_fees = opp.buy_price * (trading_fee_percent / 100.0) * 2; // Buy + sell
-        double slippage_cost = opp.buy_price * (slippage_percent / 100.0);
+        double gross_profit = opp.price_diff();
+        double trading_fees = buy_price * (trading_fee_percent / 100.0) * 2; // Buy + sell
+        double slippage_cost = buy_price * (slippage_percent / 100.0);
         
         opp.estimated_profit = gross_profit - trading_fees - slippage_cost;
         
@@ -158,24 +538,63 @@ public:
     }
     
     /**
-     * Get top N opportunities
+     * Get top N opportunities (of the shared latest_opportunities() list)
      */
     std::vector<ArbitrageOpportunity> get_top_opportunities(int n) {
-        auto all_opps = scan_opportunities();
-        if (all_opps.size() > static_cast<size_t>(n)) {
-            all_opps.resize(n);
-        }
-        return all_opps;
+        auto all_opps = latest_opportunities();
+        size_t count = std::min(all_opps->size(), static_cast<size_t>(std::max(n, 0)));
+        return std::vector<ArbitrageOpportunity>(all_opps->begin(), all_opps->begin() + count);
     }
     
     /**
      * Configuration setters
      */
-    void set_min_profit_bps(double bps) { min_profit_bps = bps; }
-    void set_trading_fee(double fee) { trading_fee_percent = fee; }
-    void set_slippage(double slip) { slippage_percent = slip; }
-    void set_opportunity_window(double window_ms) { avg_opportunity_window_ms = window_ms; }
-    void set_transmission_medium(TransmissionMedium med) { medium = med; }
+    void set_min_profit_bps(double bps) { update_setting(min_profit_bps, bps); }
+    void set_trading_fee(double fee) { update_setting(trading_fee_percent, fee); }
+    void set_slippage(double slip) { update_setting(slippage_percent, slip); }
+    void set_opportunity_window(double window_ms) { update_setting(avg_opportunity_window_ms, window_ms); }
+    void set_transmission_medium(TransmissionMedium med) { update_setting(medium, med); }
+    
+    /**
+     * Scan from the point of view of a colocation site
+     * Each venue's quote is taken as of the view time (default now) minus
+     * the network latency from the observer, so remote prices are stale.
+     * Needs PriceFeed history; an empty or unknown id scans live prices.
+     */
+    void set_observer(const std::string& exchange_id) { update_setting(observer_id, exchange_id); }
+    void clear_observer() { update_setting(observer_id, std::string()); }
+    const std::string& get_observer() const { return observer_id; }
+    
+    /**
+     * Feed time delayed views are taken at, e.g. the start of each frame;
+     * 0 = the feed clock at each scan
+     */
+    void set_view_time(uint64_t now_ns) { view_time_ns = now_ns; }
+    
+    /**
+     * Find crosses by sorting each symbol's venues by ask and bid, visiting
+     * only crossing directions, instead of comparing every pair (default on)
+     * Both find the same opportunities.
+     */
+    void set_sorted_crosses(bool enabled) { sorted_crosses = enabled; }
+    bool get_sorted_crosses() const { return sorted_crosses; }
+    
+    /**
+     * Scan symbols (and, for pair scans, tiles of venue pairs) on `threads`
+     * threads; 1 = single-threaded
+     * Each chunk of work writes its own buffer and the buffers are merged in
+     * chunk order, so results are identical for any thread count.
+     */
+    void set_worker_threads(size_t threads) {
+        workers = (threads > 1) ? std::make_unique<ThreadPool>(threads) : nullptr;
+    }
+    size_t get_worker_threads() const { return workers ? workers->size() : 1; }
+    
+    /**
+     * Buy/sell directions screened by the last scan (whole tile rows for
+     * pair scans, crossing directions when sorting crosses)
+     */
+    size_t get_last_pairs_evaluated() const { return pairs_evaluated; }
     
     /**
      * Get statistics
@@ -189,7 +608,8 @@ public:
     };
     
     ScannerStats get_statistics() {
-        auto opps = scan_opportunities();
+        auto list = latest_opportunities();
+        const auto& opps = *list;
         ScannerStats stats{};
         
         stats.total_opportunities = opps.size();
@@ -212,4 +632,304 @@ public:
         
         return stats;
     }
+    
+private:
+    template <typename T>
+    void update_setting(T& setting, T value) {
+        if (setting == value) return;
+        setting = value;
+        config_version++;
+    }
+    
+    OpportunityList latest(const ChangeSet* changed) {
+        uint64_t epoch = price_feed.get_epoch();
+        uint64_t clock = observer_clock();
+        if (cached && cached_epoch == epoch && cached_version == config_version && cached_clock == clock &&
+            (!changed || cached_incremental)) {
+            return cached;
+        }
+        // A full scan leaves the incremental table behind, so an incremental
+        // caller must not take its result (it would drop its changes).
+        // Releasing the stale list first lets an incremental scan splice it
+        // in place when no caller holds it any more.
+        cached.reset();
+        if (changed) cached = scan_opportunities(*changed);
+        else cached = std::make_shared<const std::vector<ArbitrageOpportunity>>(scan_opportunities());
+        cached_epoch = epoch;
+        cached_version = config_version;
+        cached_clock = clock;
+        cached_incremental = changed != nullptr;
+        return cached;
+    }
+    
+    /**
+     * History bucket of the view time when scanning delayed views, else 0
+     */
+    uint64_t observer_clock() const {
+        uint64_t bucket = price_feed.history_bucket_ns();
+        return (observer_id.empty() || bucket == 0) ? 0 : view_time() / bucket;
+    }
+    
+    uint64_t view_time() const { return view_time_ns ? view_time_ns : price_feed.now_ns(); }
+    
+    /**
+     * Venue handle of each exchange, resolved once per scan instead of per
+     * pair; stale or gapped venues get no handle, so they drop out of every pair
+     */
+    std::vector<int> resolve_handles() {
+        const auto& exchanges = network.get_exchanges();
+        const uint64_t* masked = price_feed.get_venue_health().mask();
+        std::vector<int> handles(exchanges.size());
+        exchange_of_venue.assign(price_feed.num_venues(), -1);
+        for (size_t i = 0; i < exchanges.size(); i++) {
+            int v = price_feed.get_venue_handle(exchanges[i].id);
+            if (v >= 0) exchange_of_venue[v] = static_cast<int>(i);
+            handles[i] = (v >= 0 && ((masked[v >> 6] >> (v & 63)) & 1)) ? -1 : v;
+        }
+        return handles;
+    }
+    
+    /**
+     * Run fn(buffer, item) over items [0, count), in contiguous chunks on the
+     * worker pool; buffers[c] belongs to chunk c and is cleared first
+     */
+    template <typename Fn>
+    void run_chunks(size_t count, Fn&& fn) {
+        size_t chunks = workers ? std::max<size_t>(1, std::min(count, workers->size() * 8)) : 1;
+        buffers.resize(chunks);
+        for (auto& buf : buffers) {
+            buf.opportunities.clear();
+            buf.found.clear();
+            buf.pairs = 0;
+        }
+        if (chunks == 1) {
+            for (size_t item = 0; item < count; item++) fn(buffers[0], item);
+            return;
+        }
+        workers->parallel_for(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+            for (size_t item = begin; item < end; item++) fn(buffers[chunk], item);
+        });
+    }
+    
+    void build_tile_pairs(size_t venues) {
+        size_t tiles = (venues + TILE_VENUES - 1) / TILE_VENUES;
+        if (tile_pairs.size() == tiles * (tiles + 1) / 2) return;
+        tile_pairs.clear();
+        for (uint32_t row = 0; row < tiles; row++) {
+            for (uint32_t column = row; column < tiles; column++) tile_pairs.emplace_back(row, column);
+        }
+    }
+    
+    /**
+     * Smallest sell/buy price ratio that can pass evaluate_opportunity():
+     * fees, slippage and the minimum profit as one markup, less a 1e-9
+     * slack so screens never drop a pair that rounding would let through
+     */
+    double profit_hurdle() const {
+        double markup = std::max({ 0.0, (2.0 * trading_fee_percent + slippage_percent) / 100.0,
+                                   min_profit_bps / 10000.0 });
+        return (1.0 + markup) / (1.0 + 1e-9);
+    }
+    
+    /**
+     * Copy one tile's quotes into contiguous doubles (bid -inf / ask +inf
+     * where the venue is not visible)
+     * @return Venues in the tile
+     */
+    static size_t gather_tile(const RowView& view, const std::vector<int>& handles, size_t begin,
+                              double* bid, double* ask) {
+        size_t count = std::min(TILE_VENUES, handles.size() - begin);
+        const double inf = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < count; k++) {
+            int v = handles[begin + k];
+            bool shown = visible(view, v);
+            bid[k] = shown ? static_cast<double>(view.bid[v]) : -inf;
+            ask[k] = shown ? static_cast<double>(view.ask[v]) : inf;
+        }
+        return count;
+    }
+    
+    static bool visible(const RowView& view, int venue) {
+        return venue >= 0 && view.bid[venue] > NO_PRICE && view.ask[venue] > NO_PRICE;
+    }
+    
+    // Rank opportunities by score
+    /**
+     * Rank order: best score first, ties by symbol then exchanges, so full
+     * and incremental scans list the same opportunities identically
+     */
+    static bool ranks_before(const ArbitrageOpportunity& a, const ArbitrageOpportunity& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.symbol != b.symbol) return a.symbol < b.symbol;
+        if (a.buy_exchange != b.buy_exchange) return a.buy_exchange < b.buy_exchange;
+        return a.sell_exchange < b.sell_exchange;
+    }
+    
+    static void rank(std::vector<ArbitrageOpportunity>& opportunities) {
+        std::sort(opportunities.begin(), opportunities.end(), ranks_before);
+    }
+    
+    /**
+     * Drop the ranked entries of every rescanned cell and merge in
+     * serial.found, keeping rank order; the list is copied first if a
+     * caller still holds it
+     */
+    void splice_found() {
+        if (ranked.use_count() > 1) ranked = std::make_shared<std::vector<ArbitrageOpportunity>>(*ranked);
+        std::vector<ArbitrageOpportunity>& list = *ranked;
+        
+        size_t exchanges = exchange_dirty.size();
+        size_t kept = list.size();
+        if (!dirty_cells.empty()) {
+            kept = 0;
+            for (size_t i = 0; i < list.size(); i++) {
+                const PairKey& key = ranked_keys[i];
+                size_t row = static_cast<size_t>(key.symbol) * exchanges;
+                if (cell_dirty[row + key.buy] || cell_dirty[row + key.sell]) continue;
+                if (kept != i) {
+                    list[kept] = std::move(list[i]);
+                    ranked_keys[kept] = key;
+                }
+                kept++;
+            }
+            for (size_t cell : dirty_cells) cell_dirty[cell] = 0;
+            dirty_cells.clear();
+        }
+        
+        // Merge from the back, so neither side is overwritten before it is read
+        auto& found = serial.found;
+        std::sort(found.begin(), found.end(), [](const PairOpportunity& a, const PairOpportunity& b) {
+            return ranks_before(a.opp, b.opp);
+        });
+        size_t total = kept + found.size();
+        list.resize(total);
+        ranked_keys.resize(total);
+        size_t i = kept, j = found.size(), out = total;
+        while (j > 0) {
+            if (i > 0 && ranks_before(found[j - 1].opp, list[i - 1])) {
+                out--;
+                i--;
+                if (out != i) {
+                    list[out] = std::move(list[i]);
+                    ranked_keys[out] = ranked_keys[i];
+                }
+            } else {
+                out--;
+                j--;
+                list[out] = std::move(found[j].opp);
+                ranked_keys[out] = found[j].key;
+            }
+        }
+        found.clear();
+    }
+    
+    void mark_dirty(uint32_t exchange) {
+        if (exchange_dirty[exchange]) return;
+        exchange_dirty[exchange] = 1;
+        dirty_exchanges.push_back(exchange);
+    }
+    
+    /**
+     * Replace one symbol's opportunities that involve a dirty exchange:
+     * drop them, then compare each dirty exchange against every other
+     * (pairs of two dirty exchanges once)
+     */
+    void rescan_dirty(int symbol, const std::vector<int>& handles, bool use_matrix) {
+        size_t row = static_cast<size_t>(symbol) * exchange_dirty.size();
+        for (uint32_t c : dirty_exchanges) {
+            cell_dirty[row + c] = 1;
+            dirty_cells.push_back(row + c);
+        }
+        
+        uint32_t key_symbol = static_cast<uint32_t>(symbol);
+        auto& found = serial.found;
+        auto emit = [&found, key_symbol](ArbitrageOpportunity& opp, size_t buy, size_t sell) {
+            found.push_back(PairOpportunity{ { key_symbol, static_cast<uint32_t>(buy), static_cast<uint32_t>(sell) }, std::move(opp) });
+        };
+        RowView view = live_row(symbol);
+        const SymbolSpec& spec = price_feed.get_symbol(symbol);
+        for (uint32_t c : dirty_exchanges) {
+            int vc = handles[c];
+            if (!visible(view, vc)) continue;
+            for (size_t j = 0; j < handles.size(); j++) {
+                if (j == c || (exchange_dirty[j] && j < c)) continue;
+                int vj = handles[j];
+                if (!visible(view, vj)) continue;
+                if (c < j) scan_pair(symbol, spec, view, c, j, vc, vj, use_matrix, serial, emit);
+                else scan_pair(symbol, spec, view, j, c, vj, vc, use_matrix, serial, emit);
+            }
+        }
+        
+        for (uint32_t c : dirty_exchanges) exchange_dirty[c] = 0;
+        dirty_exchanges.clear();
+    }
+    
+    /**
+     * Fill an opportunity's size from the buy venue's asks and the sell
+     * venue's bids (fees per side; slippage is what the depth walk models)
+     */
+    void size_against_depth(ArbitrageOpportunity& opp, int symbol, int buy_venue, int sell_venue) const {
+        DepthFill fill = match_depth(price_feed.get_book(symbol, buy_venue).get_asks(),
+                                     price_feed.get_book(symbol, sell_venue).get_bids(),
+                                     opp.tick_size, trading_fee_percent / 100.0);
+        opp.executable_size = fill.quantity;
+        opp.depth_profit = fill.profit;
+    }
+    
+    /**
+     * Live quotes of one symbol row
+     */
+    RowView live_row(int symbol) const {
+        const auto& quotes = price_feed.get_quotes();
+        size_t row = quotes.index(symbol, 0);
+        return RowView{ &quotes.bid[row], &quotes.ask[row], &quotes.ts[row] };
+    }
+    
+    /**
+     * Resolve the per-venue lookup times for the current observer
+     * @return false if scanning live prices
+     */
+    bool prepare_observer_view(const std::vector<int>& handles, bool use_matrix) {
+        if (observer_id.empty() || !price_feed.has_history()) return false;
+        int observer = network.get_exchange_index(observer_id);
+        if (observer < 0) return false;
+        
+        const auto& exchanges = network.get_exchanges();
+        uint64_t now = view_time();
+        observed_as_of.assign(price_feed.num_venues(), now);
+        for (size_t i = 0; i < exchanges.size(); i++) {
+            if (handles[i] < 0) continue;
+            double delay_ms = use_matrix ? network.latency_between(observer, i)
+                                         : network.shortest_path_latency(observer_id, exchanges[i].id);
+            uint64_t delay_ns = std::isfinite(delay_ms) ? static_cast<uint64_t>(std::llround(delay_ms * 1e6))
+                                                        : price_feed.history_horizon_ns() + 1;
+            observed_as_of[handles[i]] = now - std::min<uint64_t>(now, delay_ns);
+        }
+        
+        // Look up the whole delayed view up front, symbols in parallel
+        size_t venues = price_feed.num_venues();
+        size_t cells = price_feed.num_symbols() * venues;
+        observed_bid.assign(cells, NO_PRICE);
+        observed_ask.assign(cells, NO_PRICE);
+        observed_ts.assign(cells, 0);
+        run_chunks(price_feed.num_symbols(), [&](ScanBuffer&, size_t symbol) {
+            for (size_t v = 0; v < venues; v++) {
+                auto quote = price_feed.get_price_as_of(static_cast<int>(symbol), static_cast<int>(v), observed_as_of[v]);
+                if (!quote) continue;
+                size_t cell = symbol * venues + v;
+                observed_bid[cell] = quote->bid;
+                observed_ask[cell] = quote->ask;
+                observed_ts[cell] = quote->timestamp;
+            }
+        });
+        return true;
+    }
+    
+    /**
+     * Delayed quotes of one symbol row as seen by the observer (NO_PRICE = not yet visible)
+     */
+    RowView observed_row(int symbol) const {
+        size_t row = static_cast<size_t>(symbol) * price_feed.num_venues();
+        return RowView{ &observed_bid[row], &observed_ask[row], &observed_ts[row] };
+    }
 };
\ No newline at end of file
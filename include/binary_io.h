@@ -0,0 +1,160 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+/**
+ * 64-bit FNV-1a style checksum
+ * Folds whole 8-byte words instead of single bytes so multi-MB snapshot
+ * payloads hash at memory bandwidth
+ */
+inline uint64_t checksum64(const void* data, size_t len, uint64_t hash = 0xcbf29ce484222325ULL) {
+    const uint64_t prime = 0x100000001b3ULL;
+    const char* bytes = static_cast<const char*>(data);
+    
+    size_t words = len / 8;
+    for (size_t i = 0; i < words; i++) {
+        uint64_t w;
+        std::memcpy(&w, bytes + i * 8, 8);
+        hash = (hash ^ w) * prime;
+    }
+    for (size_t i = words * 8; i < len; i++) {
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * prime;
+    }
+    return hash;
+}
+
+/**
+ * Append-only binary buffer writer (native endianness)
+ */
+class BinaryWriter {
+private:
+    std::vector<char> buffer;
+    
+public:
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD types only");
+        const char* p = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+    
+    template <typename T>
+    void write_array(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD types only");
+        const char* p = reinterpret_cast<const char*>(values);
+        buffer.insert(buffer.end(), p, p + count * sizeof(T));
+    }
+    
+    void write_string(const std::string& str) {
+        write<uint32_t>(static_cast<uint32_t>(str.size()));
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+    
+    /**
+     * Pad with zeros so the next field starts on an `alignment` boundary
+     */
+    void align(size_t alignment) {
+        while (buffer.size() % alignment != 0) buffer.push_back(0);
+    }
+    
+    /**
+     * Overwrite a previously written POD at a fixed offset (header back-patching)
+     */
+    template <typename T>
+    void patch(size_t offset, const T& value) {
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+    
+    size_t size() const { return buffer.size(); }
+    const char* data() const { return buffer.data(); }
+    
+    /**
+     * Write the buffer to disk
+     */
+    bool save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(buffer.data(), buffer.size());
+        return static_cast<bool>(file);
+    }
+};
+
+/**
+ * Bounds-checked reader over an in-memory (typically mmap'd) buffer
+ * Any out-of-range read puts the reader into a failed state instead of
+ * touching memory past the end
+ */
+class BinaryReader {
+private:
+    const char* data;
+    size_t length;
+    size_t pos = 0;
+    bool failed = false;
+    
+public:
+    BinaryReader(const char* data, size_t length) : data(data), length(length) {}
+    
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD types only");
+        if (!require(sizeof(T))) return false;
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+    
+    template <typename T>
+    bool read_array(T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD types only");
+        if (count > length / sizeof(T) || !require(count * sizeof(T))) return false;
+        std::memcpy(values, data + pos, count * sizeof(T));
+        pos += count * sizeof(T);
+        return true;
+    }
+    
+    bool read_string(std::string& str) {
+        uint32_t len = 0;
+        if (!read(len) || !require(len)) return false;
+        str.assign(data + pos, len);
+        pos += len;
+        return true;
+    }
+    
+    /**
+     * Skip padding written by BinaryWriter::align
+     */
+    bool align(size_t alignment) {
+        size_t padded = (pos + alignment - 1) / alignment * alignment;
+        if (!require(padded - pos)) return false;
+        pos = padded;
+        return true;
+    }
+    
+    /**
+     * Pointer to the current position (for zero-copy access to arrays)
+     */
+    const char* current() const { return data + pos; }
+    bool skip(size_t bytes) {
+        if (!require(bytes)) return false;
+        pos += bytes;
+        return true;
+    }
+    
+    size_t position() const { return pos; }
+    size_t remaining() const { return length - pos; }
+    bool ok() const { return !failed; }
+    
+private:
+    bool require(size_t bytes) {
+        if (failed || bytes > length - pos) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+};
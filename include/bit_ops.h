@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Index of the lowest set bit of a bitset word or SIMD compare mask
+ * (`bits` must be non-zero)
+ */
+inline int count_trailing_zeros(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+inline int count_trailing_zeros(uint32_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+/**
+ * Number of set bits
+ */
+inline size_t popcount(uint64_t bits) {
+#if defined(_MSC_VER)
+    return static_cast<size_t>(__popcnt64(bits));
+#else
+    return static_cast<size_t>(__builtin_popcountll(bits));
+#endif
+}
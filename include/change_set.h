@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "bit_ops.h"
+
+/**
+ * Dirty bits of a symbol x venue quote matrix
+ *
+ * One bit per cell plus one per symbol and one per venue, so consumers can
+ * skip whole symbols or venues with a single test. Each symbol's cell bits
+ * start on a fresh 64-bit word: a symbol's changed venues are a contiguous
+ * word span, and threads marking disjoint symbols never share a word.
+ * Clearing only touches the rows of symbols that were marked.
+ */
+class ChangeSet {
+private:
+    std::vector<uint64_t> cell_bits;     // symbol * row_words + venue / 64
+    std::vector<uint64_t> symbol_bits;
+    std::vector<uint64_t> venue_bits;
+    size_t num_symbols = 0;
+    size_t num_venues = 0;
+    size_t row_words = 0;
+    size_t changed_cells = 0;            // Distinct cells marked since the last clear
+
+public:
+    /**
+     * Resize to a symbols x venues matrix with nothing marked
+     */
+    void resize(size_t symbols, size_t venues) {
+        num_symbols = symbols;
+        num_venues = venues;
+        row_words = (venues + 63) / 64;
+        cell_bits.assign(symbols * row_words, 0);
+        symbol_bits.assign((symbols + 63) / 64, 0);
+        venue_bits.assign(row_words, 0);
+        changed_cells = 0;
+    }
+
+    /**
+     * Mark one cell changed
+     */
+    void mark(size_t symbol, size_t venue) {
+        uint64_t bit = 1ULL << (venue & 63);
+        uint64_t& word = cell_bits[symbol * row_words + venue / 64];
+        if (word & bit) return;
+        word |= bit;
+        symbol_bits[symbol / 64] |= 1ULL << (symbol & 63);
+        venue_bits[venue / 64] |= bit;
+        changed_cells++;
+    }
+
+    /**
+     * Mark every cell changed (whole-matrix updates)
+     */
+    void mark_all() {
+        if (num_venues == 0) return;
+        fill_bits(venue_bits, num_venues);
+        fill_bits(symbol_bits, num_symbols);
+        for (size_t s = 0; s < num_symbols; s++) {
+            std::copy(venue_bits.begin(), venue_bits.end(), cell_bits.begin() + s * row_words);
+        }
+        changed_cells = num_symbols * num_venues;
+    }
+
+    /**
+     * OR another set of the same shape into this one
+     * (consumers that run less often than the feed accumulate this way)
+     */
+    void merge(const ChangeSet& other) {
+        if (other.num_symbols != num_symbols || other.num_venues != num_venues) {
+            *this = other;
+            return;
+        }
+        if (!other.any()) return;
+        for (size_t w = 0; w < venue_bits.size(); w++) venue_bits[w] |= other.venue_bits[w];
+        changed_cells = 0;
+        for (size_t w = 0; w < symbol_bits.size(); w++) {
+            symbol_bits[w] |= other.symbol_bits[w];
+        }
+        for (size_t s = 0; s < num_symbols; s++) {
+            if (!symbol_changed(s)) continue;
+            for (size_t w = 0; w < row_words; w++) {
+                uint64_t& word = cell_bits[s * row_words + w];
+                word |= other.cell_bits[s * row_words + w];
+                changed_cells += popcount(word);
+            }
+        }
+    }
+
+    /**
+     * Unmark everything; cost is proportional to the symbols marked
+     */
+    void clear() {
+        if (!any()) return;
+        for_each_symbol([this](size_t s) {
+            std::fill_n(cell_bits.begin() + s * row_words, row_words, 0);
+        });
+        std::fill(symbol_bits.begin(), symbol_bits.end(), 0);
+        std::fill(venue_bits.begin(), venue_bits.end(), 0);
+        changed_cells = 0;
+    }
+
+    size_t symbol_count() const { return num_symbols; }
+    size_t venue_count() const { return num_venues; }
+
+    bool any() const { return changed_cells != 0; }
+    size_t count() const { return changed_cells; }
+
+    bool cell_changed(size_t symbol, size_t venue) const {
+        return (cell_bits[symbol * row_words + venue / 64] >> (venue & 63)) & 1;
+    }
+    bool symbol_changed(size_t symbol) const { return (symbol_bits[symbol / 64] >> (symbol & 63)) & 1; }
+    bool venue_changed(size_t venue) const { return (venue_bits[venue / 64] >> (venue & 63)) & 1; }
+
+    /**
+     * Venue bits of one symbol (row_words() words, bit v = venue v)
+     */
+    const uint64_t* row(size_t symbol) const { return &cell_bits[symbol * row_words]; }
+    const uint64_t* venues() const { return venue_bits.data(); }
+    size_t words_per_row() const { return row_words; }
+
+    /**
+     * Visit changed symbols / venues / venues of one symbol in ascending order
+     */
+    template <typename Fn>
+    void for_each_symbol(Fn&& fn) const { for_each_bit(symbol_bits.data(), symbol_bits.size(), fn); }
+
+    template <typename Fn>
+    void for_each_venue(Fn&& fn) const { for_each_bit(venue_bits.data(), venue_bits.size(), fn); }
+
+    template <typename Fn>
+    void for_each_venue(size_t symbol, Fn&& fn) const { for_each_bit(row(symbol), row_words, fn); }
+
+private:
+    template <typename Fn>
+    static void for_each_bit(const uint64_t* words, size_t n, Fn& fn) {
+        for (size_t w = 0; w < n; w++) {
+            uint64_t bits = words[w];
+            while (bits) {
+                fn(w * 64 + count_trailing_zeros(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    static void fill_bits(std::vector<uint64_t>& words, size_t n) {
+        std::fill(words.begin(), words.end(), ~0ULL);
+        if (n % 64) words.back() = (1ULL << (n % 64)) - 1;
+    }
+};
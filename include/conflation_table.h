@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "spsc_ring.h"
+
+/**
+ * Latest-value-per-key overflow buffer between one producer and one consumer
+ *
+ * Each key owns one slot. Writing a key that is still pending overwrites
+ * it (the older value is counted as conflated and never delivered), so
+ * memory is bounded by the number of keys no matter how far the consumer
+ * falls behind. Keys that became pending are queued once, in the order
+ * they first went pending, on an SPSC ring sized for every key.
+ *
+ * The table backs up a primary queue. Each pending key remembers how many
+ * primary-queue items preceded it, and the consumer releases it only once
+ * it has taken that many, so a key's table value is never applied before
+ * its older queued values. The producer keeps writing a pending key here
+ * rather than queueing it, which keeps newer values behind it.
+ *
+ * Slots are seqlocks over relaxed atomic words: the consumer retries a
+ * read that raced with a write instead of ever blocking the producer.
+ */
+template <typename T>
+class ConflationTable {
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(sizeof(T) % sizeof(uint64_t) == 0, "T must be a whole number of 64-bit words");
+    static constexpr size_t WORDS = sizeof(T) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};   // Odd while the producer writes
+        std::atomic<bool> pending{false};
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    struct Ready {
+        uint32_t key;
+        uint64_t after;                      // Primary-queue items that must be consumed first
+    };
+    
+    std::unique_ptr<Slot[]> slots;
+    std::unique_ptr<SpscRing<Ready>> ready;      // Keys that went pending, oldest first
+    size_t num_keys = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> conflated{0};
+
+public:
+    ConflationTable() = default;
+    ConflationTable(const ConflationTable&) = delete;
+    ConflationTable& operator=(const ConflationTable&) = delete;
+
+    /**
+     * Allocate one slot per key (call while neither side is running)
+     */
+    void resize(size_t keys) {
+        num_keys = keys;
+        slots.reset(keys ? new Slot[keys] : nullptr);
+        for (size_t k = 0; k < keys; k++) {
+            for (auto& w : slots[k].words) w.store(0, std::memory_order_relaxed);
+        }
+        // A key can be queued again before the consumer releases its old entry
+        ready = keys ? std::make_unique<SpscRing<Ready>>(2 * keys) : nullptr;
+        written.store(0, std::memory_order_relaxed);
+        conflated.store(0, std::memory_order_relaxed);
+    }
+
+    size_t keys() const { return num_keys; }
+    bool enabled() const { return num_keys != 0; }
+
+    /**
+     * Producer: true if `key` holds a value the consumer has not taken yet
+     * (newer values for the key must then go through the table to keep order)
+     */
+    bool is_pending(size_t key) const {
+        return slots[key].pending.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Producer: store the latest value of `key`
+     * @param after Items the producer has put on the primary queue so far
+     */
+    void write(size_t key, const T& value, uint64_t after) {
+        Slot& slot = slots[key];
+        uint64_t words[WORDS];
+        std::memcpy(words, &value, sizeof(T));
+
+        uint32_t seq = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t w = 0; w < WORDS; w++) slot.words[w].store(words[w], std::memory_order_relaxed);
+        slot.sequence.store(seq + 2, std::memory_order_release);
+
+        written.fetch_add(1, std::memory_order_relaxed);
+        if (slot.pending.exchange(true, std::memory_order_acq_rel)) {
+            conflated.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ready->try_push(Ready{ static_cast<uint32_t>(key), after });
+        }
+    }
+
+    /**
+     * Consumer: hand up to `max_items` pending values to fn(const T&),
+     * oldest-pending key first, stopping at the first key that waits on
+     * primary-queue items beyond `primary_consumed`
+     * A key's pending flag is cleared before its slot is read, so a value
+     * written meanwhile is either read now or re-queued, never lost.
+     * @return Values delivered
+     */
+    template <typename Fn>
+    size_t consume(Fn&& fn, uint64_t primary_consumed, size_t max_items = SIZE_MAX) {
+        if (!ready) return 0;
+        return ready->consume_while([&](const Ready& entry) {
+            if (entry.after > primary_consumed) return false;
+            Slot& slot = slots[entry.key];
+            slot.pending.store(false, std::memory_order_seq_cst);
+            fn(read(slot));
+            return true;
+        }, max_items);
+    }
+
+    /**
+     * Keys waiting to be consumed (approximate while the producer runs)
+     */
+    size_t pending_keys() const { return ready ? ready->size() : 0; }
+    uint64_t total_written() const { return written.load(std::memory_order_relaxed); }
+
+    /**
+     * Values overwritten before the consumer saw them (skipped intermediate updates)
+     */
+    uint64_t total_conflated() const { return conflated.load(std::memory_order_relaxed); }
+
+private:
+    static T read(const Slot& slot) {
+        uint64_t words[WORDS];
+        for (;;) {
+            uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            for (size_t w = 0; w < WORDS; w++) words[w] = slot.words[w].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+};
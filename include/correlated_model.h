@@ -0,0 +1,142 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "aligned_allocator.h"
+#include "binary_io.h"
+#include "price_kernels.h"
+
+/**
+ * Parameters of the correlated multi-asset price model
+ *
+ * Each symbol's fair value follows a geometric Brownian motion with
+ * Merton-style jumps; the symbols' Brownian shocks are correlated. Every
+ * venue quotes fair value times (1 + basis), where the basis is an AR(1)
+ * process, so venue prices are cointegrated with fair value and with each
+ * other: they wander apart, but never for long.
+ */
+struct CorrelationParams {
+    double market_correlation = 0.3;    // Correlation between any two symbols
+    double sector_correlation = 0.3;    // Extra correlation within a sector
+    size_t sector_size = 20;            // Consecutive symbols per sector
+    double drift = 0.0;                 // Log drift per update
+    double jump_probability = 0.001;    // Chance of a jump per symbol per update
+    double jump_mean = 0.0;             // Mean log jump size
+    double jump_std = 0.02;             // Std-dev of log jump size
+    double basis_persistence = 0.9;     // Fraction of a venue's basis kept per update
+    double basis_volatility = 0.0001;   // Std-dev of basis shocks (fraction of price)
+
+    /**
+     * Dense correlation matrix implied by the market/sector structure
+     * (row-major n x n)
+     */
+    std::vector<double> correlation_matrix(size_t n) const {
+        std::vector<double> corr(n * n);
+        size_t sector = std::max<size_t>(sector_size, 1);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                if (i == j) corr[i * n + j] = 1.0;
+                else corr[i * n + j] = market_correlation + ((i / sector == j / sector) ? sector_correlation : 0.0);
+            }
+        }
+        return corr;
+    }
+};
+
+/**
+ * Lower-triangular Cholesky factor of a correlation matrix
+ *
+ * Factored once in double precision, stored as float rows padded to whole
+ * cache lines (the per-update product is bound by streaming the factor,
+ * so half the bytes is nearly half the time). multiply() turns independent
+ * N(0,1) shocks into correlated ones.
+ */
+class CholeskyFactor {
+private:
+    AlignedVector<float> lower;   // Row-major, row i holds columns [0, i]
+    size_t n = 0;
+    size_t stride = 0;
+
+public:
+    /**
+     * Factor a symmetric positive-definite n x n matrix (row-major)
+     * @return false (and an empty factor) if the matrix is not positive definite
+     */
+    bool factor(const std::vector<double>& matrix, size_t size) {
+        clear();
+        if (matrix.size() != size * size) return false;
+
+        const size_t per_line = CACHE_LINE_SIZE / sizeof(float);
+        size_t pitch = (size + per_line - 1) / per_line * per_line;
+        std::vector<double> l(size * size, 0.0);
+
+        // Row-by-row Cholesky-Crout: each entry is one dot product of two row prefixes
+        for (size_t i = 0; i < size; i++) {
+            double* li = &l[i * size];
+            for (size_t j = 0; j <= i; j++) {
+                const double* lj = &l[j * size];
+                double sum = matrix[i * size + j] - PriceKernels::dot(li, lj, j);
+                if (i == j) {
+                    if (!(sum > 0.0)) return false;
+                    li[i] = std::sqrt(sum);
+                } else {
+                    li[j] = sum / lj[j];
+                }
+            }
+        }
+
+        n = size;
+        stride = pitch;
+        lower.assign(n * stride, 0.0f);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j <= i; j++) lower[i * stride + j] = static_cast<float>(l[i * size + j]);
+        }
+        return true;
+    }
+
+    void clear() {
+        lower.clear();
+        n = 0;
+        stride = 0;
+    }
+
+    /**
+     * out[i] = sum_j L[i][j] * shocks[j] for rows [begin, end)
+     * Each row's sum is computed the same way whatever the row split,
+     * so threaded and single-threaded results are identical
+     */
+    void multiply(const float* shocks, double* out, size_t begin, size_t end) const {
+        PriceKernels::lower_matvec(lower.data(), stride, shocks, begin, std::min(end, n), out);
+    }
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    
+    /**
+     * Serialize the factored rows (restoring skips the O(N^3) factorization)
+     */
+    void write_state(BinaryWriter& out) const {
+        out.write<uint64_t>(n);
+        out.write<uint64_t>(stride);
+        out.write_array(lower.data(), lower.size());
+    }
+    
+    /**
+     * @return false (factor unchanged) on malformed input
+     */
+    bool read_state(BinaryReader& in) {
+        uint64_t size = 0, pitch = 0;
+        if (!in.read(size) || !in.read(pitch) || pitch < size ||
+            (pitch && size > in.remaining() / sizeof(float) / pitch)) {
+            return false;
+        }
+        AlignedVector<float> rows(size * pitch);
+        if (!in.read_array(rows.data(), rows.size())) return false;
+        lower = std::move(rows);
+        n = size;
+        stride = pitch;
+        return true;
+    }
+};
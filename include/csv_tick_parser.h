@@ -0,0 +1,382 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include "tick_file.h"
+#include "bit_ops.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LAS_CSV_SSE2 1
+#endif
+
+/**
+ * Column positions of a vendor tick CSV
+ * Default layout: exchange,symbol,timestamp,bid,ask,size
+ */
+struct CsvTickColumns {
+    int exchange = 0;
+    int symbol = 1;
+    int timestamp = 2;
+    int bid = 3;
+    int ask = 4;
+    int size = 5;      // -1 = no size column
+    int required = 5;  // Fields a line must have (highest required index + 1)
+    
+    /**
+     * Take positions from a header line (case-insensitive names)
+     * @return false if the line is not a recognizable header
+     */
+    bool from_header(std::string_view line) {
+        CsvTickColumns cols;
+        cols.exchange = cols.symbol = cols.timestamp = cols.bid = cols.ask = cols.size = -1;
+        
+        int index = 0;
+        size_t start = 0;
+        while (start <= line.size()) {
+            size_t comma = line.find(',', start);
+            if (comma == std::string_view::npos) comma = line.size();
+            std::string name = lowercase(trim(line.substr(start, comma - start)));
+            
+            if (name == "exchange" || name == "venue") cols.exchange = index;
+            else if (name == "symbol" || name == "instrument") cols.symbol = index;
+            else if (name == "timestamp" || name == "time" || name == "ts") cols.timestamp = index;
+            else if (name == "bid" || name == "bid_price") cols.bid = index;
+            else if (name == "ask" || name == "ask_price") cols.ask = index;
+            else if (name == "size" || name == "volume" || name == "qty") cols.size = index;
+            
+            index++;
+            start = comma + 1;
+        }
+        
+        if (cols.exchange < 0 || cols.symbol < 0 || cols.timestamp < 0 || cols.bid < 0 || cols.ask < 0) {
+            return false;
+        }
+        int highest = std::max(std::max(cols.exchange, cols.symbol), std::max(cols.timestamp, cols.bid));
+        cols.required = std::max(highest, cols.ask) + 1;
+        *this = cols;
+        return true;
+    }
+    
+private:
+    static std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '"')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '"' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+    
+    static std::string lowercase(std::string_view s) {
+        std::string out(s);
+        for (auto& c : out) c = static_cast<char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+        return out;
+    }
+};
+
+/**
+ * Parse output of one chunk of the input
+ * Record symbol/venue fields hold chunk-local dictionary ids; names are
+ * views into the (mapped) input, so the input must outlive the result
+ */
+struct CsvChunkResult {
+    std::vector<TickRecord> records;
+    std::vector<std::string_view> symbols;   // Local symbol id -> name
+    std::vector<std::string_view> venues;    // Local venue id -> name
+    uint64_t lines = 0;
+    uint64_t bad_lines = 0;
+    
+    void clear() {
+        records.clear();
+        symbols.clear();
+        venues.clear();
+        lines = 0;
+        bad_lines = 0;
+    }
+};
+
+/**
+ * Vectorized CSV tick parser
+ *
+ * Delimiters are located a whole vector at a time: the block is compared
+ * against ',' and '\n' and the resulting bitmask is walked with
+ * count-trailing-zeros, so the per-byte work is a compare rather than a
+ * branch. Numbers go through std::from_chars (no locale, no allocation).
+ * Quoted fields with embedded commas are not supported; vendor tick
+ * dumps do not use them.
+ */
+class CsvTickParser {
+public:
+    static constexpr int MAX_FIELDS = 32;
+
+#if defined(__AVX2__)
+    static constexpr size_t BLOCK = 32;
+#else
+    static constexpr size_t BLOCK = 16;
+#endif
+
+    /**
+     * Bitmask of ',' and '\n' positions in BLOCK bytes at p
+     */
+    static uint32_t delimiter_mask(const char* p) {
+#if defined(__AVX2__)
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i commas = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(','));
+        __m256i newlines = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(commas, newlines)));
+#elif defined(LAS_CSV_SSE2)
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i commas = _mm_cmpeq_epi8(block, _mm_set1_epi8(','));
+        __m128i newlines = _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(commas, newlines)));
+#else
+        return delimiter_mask_scalar(p, BLOCK);
+#endif
+    }
+    
+    /**
+     * Start of the first line at or after `pos` (pos itself if it starts a line)
+     */
+    static size_t align_to_line(const char* data, size_t size, size_t pos) {
+        if (pos == 0 || pos >= size) return std::min(pos, size);
+        if (data[pos - 1] == '\n') return pos;
+        const void* newline = std::memchr(data + pos, '\n', size - pos);
+        return newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+    }
+    
+    /**
+     * Parse every complete line in [begin, end) and append to `out`
+     */
+    static void parse_chunk(const char* begin, const char* end, const CsvTickColumns& columns,
+                            CsvChunkResult& out) {
+        std::unordered_map<std::string_view, uint32_t> symbol_ids;
+        std::unordered_map<std::string_view, uint32_t> venue_ids;
+        for (size_t i = 0; i < out.symbols.size(); i++) symbol_ids[out.symbols[i]] = static_cast<uint32_t>(i);
+        for (size_t i = 0; i < out.venues.size(); i++) venue_ids[out.venues[i]] = static_cast<uint32_t>(i);
+        
+        const char* field_begin[MAX_FIELDS];
+        const char* field_end[MAX_FIELDS];
+        int fields = 0;
+        field_begin[0] = begin;
+        
+        auto end_line = [&](const char* line_end) {
+            if (fields < MAX_FIELDS) field_end[fields] = line_end;
+            int count = std::min(fields + 1, MAX_FIELDS);
+            if (count > 1 || line_end > field_begin[0]) {
+                emit_line(field_begin, field_end, count, columns, symbol_ids, venue_ids, out);
+            }
+            fields = 0;
+            field_begin[0] = line_end + 1;
+        };
+        
+        size_t length = static_cast<size_t>(end - begin);
+        size_t i = 0;
+        while (i < length) {
+            size_t block = std::min(BLOCK, length - i);
+            uint32_t mask = (block == BLOCK) ? delimiter_mask(begin + i) : delimiter_mask_scalar(begin + i, block);
+            while (mask) {
+                const char* p = begin + i + count_trailing_zeros(mask);
+                mask &= mask - 1;
+                if (*p == ',') {
+                    // Columns past MAX_FIELDS are counted but not tracked
+                    if (fields < MAX_FIELDS) field_end[fields] = p;
+                    if (fields + 1 < MAX_FIELDS) field_begin[fields + 1] = p + 1;
+                    fields++;
+                } else {
+                    end_line(p);
+                }
+            }
+            i += block;
+        }
+        
+        // Final line without a trailing newline
+        if (field_begin[0] < end || fields > 0) end_line(end);
+    }
+    
+    /**
+     * Timestamp field -> ns since epoch
+     * Accepts integer epochs (unit inferred from digit count: s, ms, us or
+     * ns), decimal epoch seconds ("1700000000.123456") and ISO-8601 UTC
+     * ("2024-01-02T03:04:05.123456789Z", 'T' or ' ' separator)
+     */
+    static bool parse_timestamp(const char* b, const char* e, uint64_t& ns) {
+        if (e - b >= 10 && b[4] == '-') return parse_iso8601(b, e, ns);
+        
+        uint64_t whole = 0;
+        auto r = std::from_chars(b, e, whole);
+        if (r.ec != std::errc() || r.ptr == b) return false;
+        size_t digits = static_cast<size_t>(r.ptr - b);
+        
+        if (r.ptr < e && *r.ptr == '.') {
+            uint64_t fraction = 0;
+            if (!parse_fraction_ns(r.ptr + 1, e, fraction)) return false;
+            ns = whole * 1000000000ULL + fraction;
+            return true;
+        }
+        if (r.ptr != e) return false;
+        
+        if (digits >= 18) ns = whole;
+        else if (digits >= 15) ns = whole * 1000ULL;
+        else if (digits >= 12) ns = whole * 1000000ULL;
+        else ns = whole * 1000000000ULL;
+        return true;
+    }
+    
+private:
+    static uint32_t delimiter_mask_scalar(const char* p, size_t n) {
+        uint32_t mask = 0;
+        for (size_t k = 0; k < n; k++) {
+            if (p[k] == ',' || p[k] == '\n') mask |= 1u << k;
+        }
+        return mask;
+    }
+    
+    static std::string_view field(const char* const* fb, const char* const* fe, int index) {
+        const char* b = fb[index];
+        const char* e = fe[index];
+        while (e > b && (e[-1] == '\r' || e[-1] == ' ')) e--;
+        while (b < e && *b == ' ') b++;
+        return std::string_view(b, static_cast<size_t>(e - b));
+    }
+    
+    static bool parse_double(std::string_view s, double& value) {
+        if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+        auto r = std::from_chars(s.data(), s.data() + s.size(), value);
+        return r.ec == std::errc() && r.ptr == s.data() + s.size();
+    }
+    
+    /**
+     * Intern a name in a chunk dictionary
+     * @return false once the dictionary is full (ids are 16-bit on disk)
+     */
+    static bool intern(std::string_view name, std::unordered_map<std::string_view, uint32_t>& ids,
+                       std::vector<std::string_view>& names, uint16_t& id) {
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            id = static_cast<uint16_t>(it->second);
+            return true;
+        }
+        if (names.size() > UINT16_MAX) return false;
+        id = static_cast<uint16_t>(names.size());
+        ids.emplace(name, static_cast<uint32_t>(names.size()));
+        names.push_back(name);
+        return true;
+    }
+    
+    static void emit_line(const char* const* fb, const char* const* fe, int count, const CsvTickColumns& columns,
+                          std::unordered_map<std::string_view, uint32_t>& symbol_ids,
+                          std::unordered_map<std::string_view, uint32_t>& venue_ids,
+                          CsvChunkResult& out) {
+        out.lines++;
+        if (count < columns.required) {
+            out.bad_lines++;
+            return;
+        }
+        
+        TickRecord record{};
+        double bid = 0.0, ask = 0.0, size = 0.0;
+        std::string_view ts = field(fb, fe, columns.timestamp);
+        std::string_view venue = field(fb, fe, columns.exchange);
+        std::string_view symbol = field(fb, fe, columns.symbol);
+        bool ok = !venue.empty() && !symbol.empty() &&
+                  parse_timestamp(ts.data(), ts.data() + ts.size(), record.timestamp_ns) &&
+                  parse_double(field(fb, fe, columns.bid), bid) &&
+                  parse_double(field(fb, fe, columns.ask), ask);
+        if (ok && columns.size >= 0 && columns.size < count) {
+            std::string_view size_field = field(fb, fe, columns.size);
+            ok = size_field.empty() || parse_double(size_field, size);
+        }
+        if (!ok ||
+            !intern(venue, venue_ids, out.venues, record.venue) ||
+            !intern(symbol, symbol_ids, out.symbols, record.symbol)) {
+            out.bad_lines++;
+            return;
+        }
+        
+        record.bid = bid;
+        record.ask = ask;
+        record.volume = static_cast<float>(size);
+        out.records.push_back(record);
+    }
+    
+    /**
+     * Up to 9 fractional-second digits -> ns (extra digits are truncated)
+     */
+    static bool parse_fraction_ns(const char* b, const char* e, uint64_t& ns) {
+        uint64_t value = 0;
+        int digits = 0;
+        const char* p = b;
+        for (; p < e && *p >= '0' && *p <= '9'; p++) {
+            if (digits < 9) {
+                value = value * 10 + static_cast<uint64_t>(*p - '0');
+                digits++;
+            }
+        }
+        if (p == b) return false;
+        for (; digits < 9; digits++) value *= 10;
+        ns = value;
+        return p == e || (*p == 'Z' && p + 1 == e);
+    }
+    
+    static bool parse_digits(const char* p, int n, int& value) {
+        value = 0;
+        for (int k = 0; k < n; k++) {
+            if (p[k] < '0' || p[k] > '9') return false;
+            value = value * 10 + (p[k] - '0');
+        }
+        return true;
+    }
+    
+    /**
+     * Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm)
+     */
+    static int64_t days_from_civil(int y, int m, int d) {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const int64_t yoe = y - era * 400;
+        const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+    
+    static bool parse_iso8601(const char* b, const char* e, uint64_t& ns) {
+        int year, month, day, hour = 0, minute = 0, second = 0;
+        if (!parse_digits(b, 4, year) || b[4] != '-' || !parse_digits(b + 5, 2, month) ||
+            b[7] != '-' || !parse_digits(b + 8, 2, day)) {
+            return false;
+        }
+        
+        const char* p = b + 10;
+        if (p < e) {
+            if (e - p < 9 || (*p != 'T' && *p != ' ') ||
+                !parse_digits(p + 1, 2, hour) || p[3] != ':' ||
+                !parse_digits(p + 4, 2, minute) || p[6] != ':' ||
+                !parse_digits(p + 7, 2, second)) {
+                return false;
+            }
+            p += 9;
+        }
+        
+        uint64_t fraction = 0;
+        if (p < e && *p == '.') {
+            if (!parse_fraction_ns(p + 1, e, fraction)) return false;
+        } else if (p < e && !(*p == 'Z' && p + 1 == e)) {
+            return false;
+        }
+        
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+        int64_t days = days_from_civil(year, month, day);
+        if (days < 0) return false;
+        uint64_t seconds = static_cast<uint64_t>(days) * 86400ULL + hour * 3600ULL + minute * 60ULL + second;
+        ns = seconds * 1000000000ULL + fraction;
+        return true;
+    }
+};
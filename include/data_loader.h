@@ -0,0 +1,91 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "exchange.h"
+#include "symbol.h"
+#include "network_graph.h"
+
+/**
+ * Loaders for the bundled JSON data files (data/exchanges.json and
+ * data/symbols.json), shared by the simulator and the command-line tools
+ */
+
+/**
+ * Load exchanges from JSON file
+ */
+inline bool load_exchanges(const std::string& filepath, std::vector<Exchange>& exchanges) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open: " << filepath << std::endl;
+        return false;
+    }
+    
+    nlohmann::json data;
+    file >> data;
+    
+    if (!data.contains("exchanges")) {
+        std::cerr << "Invalid JSON: missing 'exchanges' field" << std::endl;
+        return false;
+    }
+    
+    for (const auto& ex_json : data["exchanges"]) {
+        std::string id = ex_json["id"];
+        std::string name = ex_json["name"];
+        std::string city = ex_json["city"];
+        double lat = ex_json["lat"];
+        double lon = ex_json["lon"];
+        std::string type_str = ex_json["type"];
+        
+        exchanges.emplace_back(id, name, city, lat, lon, string_to_exchange_type(type_str));
+    }
+    
+    std::cout << "Loaded " << exchanges.size() << " exchanges" << std::endl;
+    return !exchanges.empty();
+}
+
+/**
+ * Load exchanges from JSON file into the network (not yet connected)
+ */
+inline bool load_exchanges(const std::string& filepath, NetworkGraph& network) {
+    std::vector<Exchange> exchanges;
+    if (!load_exchanges(filepath, exchanges)) return false;
+    for (const auto& ex : exchanges) {
+        network.add_exchange(ex);
+    }
+    return true;
+}
+
+/**
+ * Load symbol universe from JSON file
+ */
+inline bool load_symbol_universe(const std::string& filepath, std::vector<SymbolSpec>& universe) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open: " << filepath << std::endl;
+        return false;
+    }
+    
+    nlohmann::json data;
+    file >> data;
+    
+    if (!data.contains("symbols")) {
+        std::cerr << "Invalid JSON: missing 'symbols' field" << std::endl;
+        return false;
+    }
+    
+    for (const auto& sym_json : data["symbols"]) {
+        SymbolSpec spec;
+        spec.name = sym_json["symbol"];
+        spec.base_price = sym_json["base_price"];
+        spec.volatility = sym_json.value("volatility", spec.volatility);
+        spec.tick_size = sym_json.value("tick_size", spec.tick_size);
+        universe.push_back(spec);
+    }
+    
+    std::cout << "Loaded " << universe.size() << " symbols" << std::endl;
+    return !universe.empty();
+}
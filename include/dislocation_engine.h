@@ -0,0 +1,312 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "timer_wheel.h"
+#include "price_feed.h"
+#include "philox.h"
+#include "binary_io.h"
+
+/**
+ * How a dislocation fades over its lifetime
+ */
+enum class DecayCurve {
+    STEP,          // Full magnitude until it expires
+    LINEAR,        // Straight line down to zero at expiry
+    EXPONENTIAL    // exp(-5 t / duration), cut to zero at expiry
+};
+
+/**
+ * One transient price dislocation of a symbol on a venue
+ */
+struct DislocationSpec {
+    int symbol = 0;
+    int venue = 0;
+    double magnitude = 0.005;        // Peak relative price shift (0.005 = +0.5%)
+    uint64_t duration_ns = 2000000000;
+    DecayCurve curve = DecayCurve::LINEAR;
+};
+
+/**
+ * Schedules transient dislocations against a PriceFeed
+ *
+ * Each active dislocation contributes a time-varying displacement to its
+ * cell (PriceFeed::add_displacement); overlapping ones add up. Dislocations
+ * wake on a hierarchical timer wheel: at their start time, then every
+ * `step_ns` (or once per advance() when calls are further apart) while
+ * their curve is still moving (a STEP dislocation only wakes to start and
+ * to expire), so thousands can be in flight at a cost proportional to the
+ * ones that are actually due.
+ */
+class DislocationEngine {
+private:
+    struct Active {
+        DislocationSpec spec;
+        uint64_t start_ns;
+        double applied;       // Displacement currently contributed to the cell
+        bool live;
+    };
+    std::vector<Active> pool;
+    std::vector<uint32_t> free_slots;
+    TimerWheel<uint32_t> wheel;
+    uint64_t step_ns;
+    uint64_t origin_ns = 0;   // Feed time of wheel step 0
+    bool started = false;
+    size_t active_count = 0;
+
+    CounterRng rng;
+    uint64_t random_draws = 0;
+    static constexpr uint32_t STREAM_DISLOCATION = 5;  // 0-4 are used by PriceFeed/TickArrivalModel
+
+    uint64_t scheduled_total = 0;
+    uint64_t expired_total = 0;
+
+public:
+    /**
+     * @param step_ns Time resolution of starts, decay updates and expiry
+     */
+    explicit DislocationEngine(uint64_t seed = 0, uint64_t step_ns = 1000000)
+        : step_ns(std::max<uint64_t>(step_ns, 1)), rng(seed) {}
+
+    /**
+     * Schedule a dislocation to start at feed time `start_ns`
+     */
+    void schedule(const DislocationSpec& spec, uint64_t start_ns) {
+        if (!started) anchor(start_ns);
+        uint32_t id;
+        if (!free_slots.empty()) {
+            id = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            id = static_cast<uint32_t>(pool.size());
+            pool.emplace_back();
+        }
+        pool[id] = Active{ spec, start_ns, 0.0, false };
+        wheel.schedule(to_step(start_ns), id);
+        scheduled_total++;
+    }
+
+    /**
+     * Schedule `count` dislocations spread uniformly over [start_ns, start_ns + spread_ns)
+     * on random cells, with magnitudes uniform in +-[min_magnitude, max_magnitude],
+     * durations uniform in [min_duration_ns, max_duration_ns] and random curves
+     */
+    void schedule_random(const PriceFeed& feed, size_t count, uint64_t start_ns, uint64_t spread_ns,
+                         double min_magnitude, double max_magnitude,
+                         uint64_t min_duration_ns, uint64_t max_duration_ns) {
+        if (feed.num_symbols() == 0 || feed.num_venues() == 0) return;
+        for (size_t k = 0; k < count; k++) {
+            auto r = rng.draw(random_draws++, 0, 0, STREAM_DISLOCATION);
+            double u_mag = uniform(r.v[2]);
+            double u_dur = uniform(r.v[3]);
+
+            DislocationSpec spec;
+            spec.symbol = static_cast<int>(r.v[0] % feed.num_symbols());
+            spec.venue = static_cast<int>(r.v[1] % feed.num_venues());
+            spec.magnitude = (min_magnitude + (max_magnitude - min_magnitude) * u_mag) * ((r.v[0] >> 31) ? -1.0 : 1.0);
+            spec.duration_ns = min_duration_ns + static_cast<uint64_t>((max_duration_ns - min_duration_ns) * u_dur);
+            spec.curve = static_cast<DecayCurve>((r.v[1] >> 16) % 3);
+            uint64_t offset = spread_ns ? static_cast<uint64_t>(spread_ns * uniform(r.v[1] ^ r.v[3])) : 0;
+            schedule(spec, start_ns + offset);
+        }
+    }
+
+    /**
+     * Start, update and expire every dislocation due up to feed time `now_ns`
+     * A late call catches each dislocation up in one wakeup, evaluated at
+     * `now_ns`, instead of replaying every step it missed.
+     * @return Dislocations processed
+     */
+    size_t advance(PriceFeed& feed, uint64_t now_ns) {
+        if (!started || now_ns < origin_ns) return 0;
+        uint64_t now_step = to_step(now_ns);
+        return wheel.advance(now_step, [&](uint32_t id, uint64_t due) {
+            Active& a = pool[id];
+            uint64_t t = std::max(origin_ns + due * step_ns, now_ns);
+            uint64_t age = (t > a.start_ns) ? t - a.start_ns : 0;
+            if (!a.live) {
+                a.live = true;
+                active_count++;
+            }
+
+            if (age >= a.spec.duration_ns) {
+                feed.add_displacement(a.spec.symbol, a.spec.venue, -a.applied);
+                a.live = false;
+                active_count--;
+                expired_total++;
+                free_slots.push_back(id);
+                return;
+            }
+
+            double value = a.spec.magnitude * shape(a.spec.curve, static_cast<double>(age) / a.spec.duration_ns);
+            feed.add_displacement(a.spec.symbol, a.spec.venue, value - a.applied);
+            a.applied = value;
+
+            uint64_t end_step = to_step(a.start_ns + a.spec.duration_ns);
+            uint64_t next = (a.spec.curve == DecayCurve::STEP)
+                ? end_step
+                : std::min(std::max(due + 1, now_step + 1), end_step);
+            wheel.schedule(next, id);
+        });
+    }
+
+    /**
+     * Drop every dislocation, taking live ones back out of the feed
+     * (pass nullptr after the feed was re-initialized)
+     */
+    void clear(PriceFeed* feed) {
+        if (feed) {
+            for (const Active& a : pool) {
+                if (a.live) feed->add_displacement(a.spec.symbol, a.spec.venue, -a.applied);
+            }
+        }
+        pool.clear();
+        free_slots.clear();
+        wheel.reset();
+        started = false;
+        active_count = 0;
+    }
+
+    size_t active() const { return active_count; }
+    size_t pending() const { return wheel.size() - active_count; }
+    uint64_t total_scheduled() const { return scheduled_total; }
+    uint64_t total_expired() const { return expired_total; }
+    uint64_t get_step_ns() const { return step_ns; }
+    
+    /**
+     * Serialize every scheduled and live dislocation, the random-schedule
+     * counter and the statistics (pair with the PriceFeed's state, which
+     * holds the displacements live ones have applied)
+     */
+    void write_state(BinaryWriter& out) const {
+        out.write<uint64_t>(rng.seed());
+        out.write(step_ns);
+        out.write(origin_ns);
+        out.write<uint64_t>(started ? 1 : 0);
+        out.write(random_draws);
+        out.write(scheduled_total);
+        out.write(expired_total);
+        out.write(wheel.now());
+        
+        out.write<uint64_t>(pool.size());
+        for (const Active& a : pool) {
+            out.write<int32_t>(a.spec.symbol);
+            out.write<int32_t>(a.spec.venue);
+            out.write(a.spec.magnitude);
+            out.write(a.spec.duration_ns);
+            out.write(static_cast<uint32_t>(a.spec.curve));
+            out.write<uint32_t>(a.live ? 1 : 0);
+            out.write(a.start_ns);
+            out.write(a.applied);
+        }
+        out.write<uint64_t>(free_slots.size());
+        out.write_array(free_slots.data(), free_slots.size());
+        
+        out.write<uint64_t>(wheel.size());
+        wheel.for_each([&out](uint32_t id, uint64_t due) {
+            out.write(due);
+            out.write(id);
+        });
+    }
+    
+    /**
+     * Replace the schedule with one written by write_state()
+     * @param time_shift_ns Added to every feed time (moves a saved run to the current clock)
+     * @return false (engine unchanged) on malformed input
+     */
+    bool read_state(BinaryReader& in, uint64_t time_shift_ns = 0) {
+        uint64_t seed = 0, step = 0, origin = 0, was_started = 0, now_step = 0;
+        in.read(seed);
+        in.read(step);
+        in.read(origin);
+        in.read(was_started);
+        
+        DislocationEngine next(seed, step);
+        in.read(next.random_draws);
+        in.read(next.scheduled_total);
+        in.read(next.expired_total);
+        in.read(now_step);
+        
+        uint64_t slots = 0;
+        if (!in.read(slots) || slots > in.remaining()) return false;
+        next.pool.resize(slots);
+        for (Active& a : next.pool) {
+            int32_t symbol = 0, venue = 0;
+            uint32_t curve = 0, live = 0;
+            in.read(symbol);
+            in.read(venue);
+            in.read(a.spec.magnitude);
+            in.read(a.spec.duration_ns);
+            in.read(curve);
+            in.read(live);
+            in.read(a.start_ns);
+            in.read(a.applied);
+            if (curve > static_cast<uint32_t>(DecayCurve::EXPONENTIAL)) return false;
+            a.spec.symbol = symbol;
+            a.spec.venue = venue;
+            a.spec.curve = static_cast<DecayCurve>(curve);
+            a.live = live != 0;
+            a.start_ns += time_shift_ns;
+            if (a.live) next.active_count++;
+        }
+        
+        uint64_t free_count = 0;
+        if (!in.read(free_count) || free_count > slots) return false;
+        next.free_slots.resize(free_count);
+        in.read_array(next.free_slots.data(), free_count);
+        // schedule() reuses these slots as-is: each must exist, be idle and appear once
+        std::vector<uint8_t> freed(slots, 0);
+        for (uint32_t id : next.free_slots) {
+            if (id >= slots || next.pool[id].live || freed[id]) return false;
+            freed[id] = 1;
+        }
+        
+        uint64_t timers = 0;
+        if (!in.read(timers) || timers > slots) return false;
+        next.origin_ns = origin + time_shift_ns;
+        next.started = was_started != 0;
+        next.wheel.reset(now_step);
+        for (uint64_t k = 0; k < timers; k++) {
+            uint64_t due = 0;
+            uint32_t id = 0;
+            in.read(due);
+            in.read(id);
+            if (!in.ok() || id >= slots) return false;
+            next.wheel.schedule(due, id);
+        }
+        if (!in.ok()) return false;
+        
+        *this = std::move(next);
+        return true;
+    }
+
+    /**
+     * Fraction of the magnitude left at `progress` (0..1) of the lifetime
+     */
+    static double shape(DecayCurve curve, double progress) {
+        switch (curve) {
+            case DecayCurve::STEP: return 1.0;
+            case DecayCurve::LINEAR: return 1.0 - progress;
+            case DecayCurve::EXPONENTIAL: return std::exp(-5.0 * progress);
+        }
+        return 0.0;
+    }
+
+private:
+    void anchor(uint64_t now_ns) {
+        origin_ns = now_ns;
+        wheel.reset(0);
+        started = true;
+    }
+
+    // Steps round up, so nothing starts or expires early
+    uint64_t to_step(uint64_t t_ns) const {
+        return (t_ns <= origin_ns) ? 0 : (t_ns - origin_ns + step_ns - 1) / step_ns;
+    }
+
+    static double uniform(uint32_t bits) {
+        return bits * (1.0 / 4294967296.0);
+    }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "binary_io.h"
+#include "mapped_file.h"
+#include "price_feed.h"
+#include "dislocation_engine.h"
+
+/**
+ * On-disk header of a feed checkpoint
+ * Layout: header | feed state | producer feed state | dislocation state
+ * (absent sections have size 0). The whole payload is checksummed.
+ */
+struct FeedCheckpointHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t saved_ns;            // Feed clock when saved
+    uint64_t feed_size;
+    uint64_t producer_size;       // Simulated market of a feed handler thread (optional)
+    uint64_t dislocations_size;   // Scheduled and live dislocations (optional)
+    uint64_t payload_checksum;    // checksum64 of everything after the header
+};
+
+constexpr uint64_t FEED_CHECKPOINT_MAGIC = 0x3144454546534CULL;  // "LSFEED1"
+constexpr uint32_t FEED_CHECKPOINT_VERSION = 1;
+
+/**
+ * Write a binary checkpoint of a running simulation
+ * @param producer The feed handler's simulated market when quotes are
+ *                 generated on another thread (its generator state is the
+ *                 one that matters); stop the handler first
+ * @param dislocations Pending and live dislocations applied to `feed`
+ * @return false if the file cannot be written
+ */
+inline bool save_feed_checkpoint(const std::string& path, const PriceFeed& feed,
+                                 const PriceFeed* producer = nullptr,
+                                 const DislocationEngine* dislocations = nullptr) {
+    BinaryWriter writer;
+    FeedCheckpointHeader header{};
+    writer.write(header); // Back-patched below
+    
+    size_t start = writer.size();
+    feed.write_state(writer);
+    header.feed_size = writer.size() - start;
+    
+    start = writer.size();
+    if (producer) producer->write_state(writer);
+    header.producer_size = writer.size() - start;
+    
+    start = writer.size();
+    if (dislocations) dislocations->write_state(writer);
+    header.dislocations_size = writer.size() - start;
+    
+    header.magic = FEED_CHECKPOINT_MAGIC;
+    header.version = FEED_CHECKPOINT_VERSION;
+    header.header_size = sizeof(FeedCheckpointHeader);
+    header.saved_ns = feed.now_ns();
+    header.payload_checksum = checksum64(writer.data() + sizeof(header), writer.size() - sizeof(header));
+    writer.patch(0, header);
+    
+    return writer.save(path);
+}
+
+/**
+ * Restore a checkpoint written by save_feed_checkpoint()
+ * Every timestamp moves forward by the time since the save, so a resumed
+ * run carries on from "now" and its dislocations keep their remaining
+ * lifetimes. Sections missing from the file leave the matching argument
+ * untouched (a missing dislocation section clears `dislocations`).
+ * @return false (nothing changed) on a missing, corrupt or
+ *         version-mismatched file
+ */
+inline bool load_feed_checkpoint(const std::string& path, PriceFeed& feed,
+                                 PriceFeed* producer = nullptr,
+                                 DislocationEngine* dislocations = nullptr) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    
+    BinaryReader reader(file.data(), file.size());
+    FeedCheckpointHeader header;
+    if (!reader.read(header) ||
+        header.magic != FEED_CHECKPOINT_MAGIC ||
+        header.version != FEED_CHECKPOINT_VERSION ||
+        header.header_size != sizeof(FeedCheckpointHeader) ||
+        header.feed_size > reader.remaining() ||
+        header.producer_size > reader.remaining() - header.feed_size ||
+        header.dislocations_size != reader.remaining() - header.feed_size - header.producer_size ||
+        checksum64(reader.current(), reader.remaining()) != header.payload_checksum) {
+        return false;
+    }
+    
+    uint64_t now = feed.now_ns();
+    uint64_t shift = (now > header.saved_ns) ? now - header.saved_ns : 0;
+    const char* base = reader.current();
+    
+    // The checksum has vouched for the bytes; each section still validates its
+    // own structure. Everything is parsed before anything is replaced.
+    DislocationEngine restored_dislocations;
+    if (dislocations && header.dislocations_size) {
+        BinaryReader section(base + header.feed_size + header.producer_size, header.dislocations_size);
+        if (!restored_dislocations.read_state(section, shift)) return false;
+    }
+    PriceFeed restored_producer;
+    bool has_producer = producer && header.producer_size;
+    if (has_producer) {
+        BinaryReader section(base + header.feed_size, header.producer_size);
+        if (!PriceFeed::parse_state(section, restored_producer, shift)) return false;
+    }
+    PriceFeed restored_feed;
+    BinaryReader section(base, header.feed_size);
+    if (!PriceFeed::parse_state(section, restored_feed, shift)) return false;
+    
+    feed.adopt_state(std::move(restored_feed));
+    if (has_producer) producer->adopt_state(std::move(restored_producer));
+    if (dislocations) *dislocations = std::move(restored_dislocations);
+    return true;
+}
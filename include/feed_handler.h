@@ -0,0 +1,354 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include "spsc_ring.h"
+#include "conflation_table.h"
+#include "venue_health.h"
+#include "price_feed.h"
+#include "tick_arrival_model.h"
+#include "tsc_clock.h"
+
+/**
+ * One top-of-book update passed from the feed handler to the consumer
+ * (32 bytes, two per cache line)
+ */
+struct QuoteUpdate {
+    uint64_t timestamp;   // Nanoseconds since epoch (as PriceFeed)
+    uint16_t symbol;      // Feed symbol handle
+    uint16_t venue;       // Feed venue handle
+    float volume;
+    double bid;
+    double ask;
+};
+static_assert(sizeof(QuoteUpdate) == 32, "QuoteUpdate must stay 32 bytes");
+
+/**
+ * Runs quote ingestion on its own thread
+ *
+ * A source callable is invoked in a loop on the handler thread and
+ * publishes updates through apply_quote()/publish(); the consumer (the UI
+ * loop, before scanning) applies them to its PriceFeed with drain_into().
+ * The two sides share nothing but an SPSC ring, so ingestion never waits
+ * on a frame and the consumer never takes a lock. When the ring is full
+ * the producer yields until space frees up (backpressure, no drops).
+ *
+ * With conflation enabled the producer never waits: updates that find the
+ * ring full go to a per-(symbol, venue) ConflationTable that keeps only
+ * the latest quote of each cell, and once a cell is in the table its newer
+ * updates follow it there. The consumer drains the ring, then the table,
+ * where a cell waits until the ring entries queued before it have been
+ * applied, so per-cell order holds. Backlog is bounded by ring + one slot
+ * per cell, and skipped intermediate quotes are counted.
+ *
+ * Sequence numbers are checked on the handler thread, where every update
+ * is still visible (conflation skips sequences on purpose). Duplicates are
+ * dropped there; gaps are counted per venue and handed to the feed's
+ * VenueHealth by drain_into().
+ */
+class FeedHandler {
+public:
+    // Called repeatedly on the handler thread; returns updates published
+    // (0 = idle, the thread sleeps briefly before calling again)
+    using Source = std::function<size_t(FeedHandler&)>;
+    
+private:
+    SpscRing<QuoteUpdate> ring;
+    ConflationTable<QuoteUpdate> overflow;  // Empty = block when the ring is full
+    size_t overflow_venues = 0;             // Key = symbol * overflow_venues + venue
+    uint64_t ring_pushed = 0;               // Producer: updates put on the ring
+    uint64_t ring_drained = 0;              // Consumer: updates taken off the ring
+    SequenceTracker sequences;              // Producer: per-venue sequence check (empty = off)
+    std::unique_ptr<std::atomic<uint64_t>[]> venue_gaps;  // Producer -> consumer: sequences missed per venue
+    std::vector<uint64_t> reported_gaps;    // Consumer: venue_gaps already passed to the feed
+    std::atomic<uint64_t> duplicates{0};    // Sequenced updates dropped as replays
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> stalls{0};      // Publishes that found the ring full
+    
+    // Consumer-side statistics
+    uint64_t drained = 0;
+    uint64_t rate_window_start_count = 0;
+    std::chrono::steady_clock::time_point rate_window_start = std::chrono::steady_clock::now();
+    double drain_rate = 0.0;
+    
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    
+    explicit FeedHandler(size_t capacity = DEFAULT_CAPACITY) : ring(capacity) {}
+    ~FeedHandler() { stop(); }
+    
+    FeedHandler(const FeedHandler&) = delete;
+    FeedHandler& operator=(const FeedHandler&) = delete;
+    
+    /**
+     * Start the handler thread (stops a running one first)
+     */
+    void start(Source source) {
+        stop();
+        running.store(true, std::memory_order_release);
+        worker = std::thread([this, source = std::move(source)]() mutable {
+            while (running.load(std::memory_order_acquire)) {
+                if (source(*this) == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    
+    /**
+     * Stop and join the handler thread; queued updates stay in the ring
+     */
+    void stop() {
+        running.store(false, std::memory_order_release);
+        if (worker.joinable()) worker.join();
+    }
+    
+    bool is_running() const { return running.load(std::memory_order_acquire); }
+    
+    /**
+     * Conflate instead of blocking when the ring is full
+     * (call while the handler thread is stopped; 0 x 0 switches back to blocking)
+     */
+    void enable_conflation(size_t symbols, size_t venues) {
+        overflow_venues = venues;
+        overflow.resize(symbols * venues);
+    }
+    
+    void disable_conflation() { enable_conflation(0, 0); }
+    bool conflating() const { return overflow.enabled(); }
+    
+    /**
+     * Check per-venue sequence numbers of published updates and restart
+     * every venue's stream (call while the handler thread is stopped; 0 = off)
+     */
+    void track_sequences(size_t venues) {
+        sequences.resize(venues);
+        venue_gaps.reset(venues ? new std::atomic<uint64_t>[venues] : nullptr);
+        for (size_t v = 0; v < venues; v++) venue_gaps[v].store(0, std::memory_order_relaxed);
+        reported_gaps.assign(venues, 0);
+    }
+    
+    /**
+     * Producer: queue one update, yielding while the ring is full
+     * @param sequence Per-venue sequence number (0 = unsequenced)
+     * @return false if the handler was stopped before space freed up
+     */
+    bool publish(const QuoteUpdate& update, uint32_t sequence = 0) {
+        if (sequence != 0 && update.venue < sequences.venues()) {
+            uint32_t missed = 0;
+            switch (sequences.check(update.venue, sequence, &missed)) {
+                case SequenceCheck::DUPLICATE:
+                    duplicates.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                case SequenceCheck::GAP:
+                    venue_gaps[update.venue].fetch_add(missed, std::memory_order_release);
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        if (overflow.enabled() && update.venue < overflow_venues) {
+            size_t key = static_cast<size_t>(update.symbol) * overflow_venues + update.venue;
+            if (key < overflow.keys()) {
+                if (!overflow.is_pending(key) && ring.try_push(update)) ring_pushed++;
+                else overflow.write(key, update, ring_pushed);
+                published.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        
+        if (!ring.try_push(update)) {
+            stalls.fetch_add(1, std::memory_order_relaxed);
+            do {
+                if (!running.load(std::memory_order_acquire)) return false;
+                std::this_thread::yield();
+            } while (!ring.try_push(update));
+        }
+        ring_pushed++;
+        published.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    /**
+     * Producer: PriceFeed-compatible sink, so TickReplay can pump into the
+     * handler exactly as it pumps into a feed
+     */
+    void apply_quote(int symbol, int venue, double bid, double ask, double volume, uint64_t timestamp,
+                     uint32_t sequence = 0) {
+        QuoteUpdate update;
+        update.timestamp = timestamp;
+        update.symbol = static_cast<uint16_t>(symbol);
+        update.venue = static_cast<uint16_t>(venue);
+        update.volume = static_cast<float>(volume);
+        update.bid = bid;
+        update.ask = ask;
+        publish(update, sequence);
+    }
+    
+    /**
+     * Consumer: apply up to `max_updates` queued updates to a feed
+     * @return Updates applied
+     */
+    size_t drain_into(PriceFeed& feed, size_t max_updates = SIZE_MAX) {
+        auto apply = [&feed](const QuoteUpdate& u) {
+            feed.apply_quote(u.symbol, u.venue, u.bid, u.ask, u.volume, u.timestamp);
+        };
+        // Ring first; the table holds each cell back until its older ring entries are applied
+        size_t n = ring.consume(apply, max_updates);
+        ring_drained += n;
+        if (n < max_updates) n += overflow.consume(apply, ring_drained, max_updates - n);
+        drained += n;
+        
+        for (size_t v = 0; v < reported_gaps.size(); v++) {
+            uint64_t gaps = venue_gaps[v].load(std::memory_order_acquire);
+            if (gaps == reported_gaps[v]) continue;
+            feed.report_venue_gap(static_cast<int>(v), gaps - reported_gaps[v]);
+            reported_gaps[v] = gaps;
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        double window = std::chrono::duration<double>(now - rate_window_start).count();
+        if (window >= 1.0) {
+            drain_rate = (drained - rate_window_start_count) / window;
+            rate_window_start = now;
+            rate_window_start_count = drained;
+        }
+        return n;
+    }
+    
+    uint64_t total_published() const { return published.load(std::memory_order_relaxed); }
+    uint64_t total_drained() const { return drained; }
+    uint64_t total_stalls() const { return stalls.load(std::memory_order_relaxed); }
+    uint64_t total_duplicates() const { return duplicates.load(std::memory_order_relaxed); }
+    size_t queued() const { return ring.size() + overflow.pending_keys(); }
+    
+    /**
+     * Updates that went through the conflation table / were overwritten
+     * there before being applied (skipped intermediate ticks)
+     */
+    uint64_t total_overflowed() const { return overflow.total_written(); }
+    uint64_t total_conflated() const { return overflow.total_conflated(); }
+    size_t capacity() const { return ring.capacity(); }
+    
+    /**
+     * Updates applied per second over the last ~1 s window
+     */
+    double ingest_rate() const { return drain_rate; }
+};
+
+/**
+ * Quote source that runs the simulated market on a producer thread
+ *
+ * Owns its own PriceFeed (same seed and universe as the consumer's, so
+ * both start from identical quotes) and publishes every cell it changes:
+ * each event of a TickArrivalModel, or the whole matrix once per second
+ * in synchronous mode. Any sink with PriceFeed's apply_quote() signature
+ * works (FeedHandler, ShmQuotePublisher).
+ */
+class SimulatedFeedSource {
+private:
+    PriceFeed feed;
+    std::optional<TickArrivalModel> model;   // Empty = synchronous updates
+    std::optional<ArrivalParams> arrival_params;  // Process the model was built with
+    uint64_t model_seed = 0;
+    uint64_t start_ns = TscClock::now_ns();  // Model time zero
+    double next_sync = 1.0;                  // Seconds since start of the next synchronous update
+    std::vector<uint32_t> venue_sequence;    // Last sequence number published per venue
+    
+public:
+    /**
+     * @param arrivals Event-driven arrival process, or nullopt for one
+     *                 synchronous update per second
+     */
+    SimulatedFeedSource(uint64_t seed, const std::vector<Exchange>& exchanges,
+                        const std::vector<SymbolSpec>& universe,
+                        const std::optional<ArrivalParams>& arrivals)
+        : feed(seed) {
+        feed.initialize_feeds(exchanges, universe);
+        venue_sequence.assign(feed.num_venues(), 0);
+        set_arrivals(arrivals);
+    }
+    
+    /**
+     * Switch the arrival process; quotes carry on from their current values
+     * (call only while the handler thread is stopped, and after restoring
+     * get_feed() from a checkpoint). The pending arrivals are kept when the
+     * process, seed and stream count are unchanged.
+     */
+    void set_arrivals(const std::optional<ArrivalParams>& arrivals) {
+        double now = elapsed();
+        venue_sequence.resize(feed.num_venues());
+        size_t streams = feed.num_symbols() * feed.num_venues();
+        if (arrivals == arrival_params && model_seed == feed.get_seed() &&
+            (!model || model->num_streams() == streams)) {
+            return;
+        }
+        arrival_params = arrivals;
+        model_seed = feed.get_seed();
+        model.reset();
+        next_sync = std::floor(now) + 1.0;
+        if (arrivals) {
+            model.emplace(feed.get_seed());
+            model->initialize(feed.num_symbols(), feed.num_venues(), *arrivals, now);
+        }
+    }
+    
+    /**
+     * Producer-side feed, for configuration before the handler starts
+     */
+    PriceFeed& get_feed() { return feed; }
+    
+    /**
+     * Publish everything due at the current wall time
+     * @return Updates published (0 = nothing due yet)
+     */
+    template <typename Sink>
+    size_t operator()(Sink& out) {
+        double now = elapsed();
+        
+        if (model) {
+            // Each quote is stamped with its own arrival time, not the batch's
+            return model->advance_until(now, [&](const TickEvent& event) {
+                feed.apply_tick(event.symbol, event.venue, start_ns + static_cast<uint64_t>(event.time * 1e9));
+                publish_cell(out, event.symbol, event.venue);
+            });
+        }
+        
+        if (now < next_sync) return 0;
+        next_sync += 1.0;
+        feed.update_prices();
+        for (size_t s = 0; s < feed.num_symbols(); s++) {
+            for (size_t v = 0; v < feed.num_venues(); v++) {
+                publish_cell(out, s, v);
+            }
+        }
+        return feed.num_symbols() * feed.num_venues();
+    }
+    
+private:
+    template <typename Sink>
+    void publish_cell(Sink& out, size_t symbol, size_t venue) {
+        // Sinks take prices, like recorded and wire quotes; the consuming
+        // PriceFeed rounds them back onto the same tick grid
+        const QuoteStore& quotes = feed.get_quotes();
+        size_t i = quotes.index(symbol, venue);
+        double tick_size = quotes.tick_size[symbol];
+        out.apply_quote(static_cast<int>(symbol), static_cast<int>(venue),
+                        quotes.bid[i] * tick_size, quotes.ask[i] * tick_size, quotes.volume[i], quotes.ts[i],
+                        ++venue_sequence[venue]);
+    }
+    
+    double elapsed() const {
+        return (TscClock::now_ns() - start_ns) * 1e-9;
+    }
+};
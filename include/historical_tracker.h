@@ -1,15 +1,16 @@
 #pragma once
 
 #include <vector>
-#include <chrono>
+#include <utility>
 #include "arbitrage_scanner.h"
+#include "tsc_clock.h"
 
 /**
  * Snapshot of opportunities at a point in time
  */
 struct OpportunitySnapshot {
-    uint64_t timestamp;
-    std::vector<ArbitrageOpportunity> opportunities;
+    uint64_t timestamp;   // Nanoseconds since epoch (TscClock)
+    ArbitrageScanner::OpportunityList opportunities;   // Shared with the scanner, not copied
     int total_count;
     int executable_count;
     double avg_profit;
@@ -33,14 +34,16 @@ public:
     
     /**
      * Record current opportunities
+     * The scanner never mutates a list it has handed out, so the snapshot
+     * keeps a reference to it instead of a copy.
      */
-    void record(const std::vector<ArbitrageOpportunity>& opportunities) {
+    void record(const ArbitrageScanner::OpportunityList& list) {
+        static const std::vector<ArbitrageOpportunity> none;
+        const std::vector<ArbitrageOpportunity>& opportunities = list ? *list : none;
         OpportunitySnapshot snapshot;
-        snapshot.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
+        snapshot.timestamp = TscClock::now_ns();
         
-        snapshot.opportunities = opportunities;
+        snapshot.opportunities = list;
         snapshot.total_count = opportunities.size();
         snapshot.executable_count = 0;
         snapshot.avg_profit = 0;
@@ -58,7 +61,7 @@ public:
             snapshot.avg_profit /= opportunities.size();
         }
         
-        history.push_back(snapshot);
+        history.push_back(std::move(snapshot));
         
         // Maintain max size
         if (history.size() > max_history_size) {
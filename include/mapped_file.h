@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Read-only memory-mapped file
+ * Maps a whole file into the address space so large binary blobs can be
+ * validated and parsed in place without a read() copy
+ */
+class MappedFile {
+private:
+    const char* data_ptr = nullptr;
+    size_t file_size = 0;
+#ifdef _WIN32
+    HANDLE file_handle = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    /**
+     * Map a file read-only
+     * @return false if the file cannot be opened or is empty
+     */
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE) return false;
+        
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_handle, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        file_size = static_cast<size_t>(size.QuadPart);
+        
+        mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_handle) {
+            close();
+            return false;
+        }
+        data_ptr = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close();
+            return false;
+        }
+        file_size = static_cast<size_t>(st.st_size);
+        
+        void* ptr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        data_ptr = (ptr == MAP_FAILED) ? nullptr : static_cast<const char*>(ptr);
+#endif
+        if (!data_ptr) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * Unmap and release the file
+     */
+    void close() {
+#ifdef _WIN32
+        if (data_ptr) UnmapViewOfFile(data_ptr);
+        if (mapping_handle) CloseHandle(mapping_handle);
+        if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+        mapping_handle = nullptr;
+        file_handle = INVALID_HANDLE_VALUE;
+#else
+        if (data_ptr) munmap(const_cast<char*>(data_ptr), file_size);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        data_ptr = nullptr;
+        file_size = 0;
+    }
+    
+    /**
+     * Hint that the mapping will be read front to back (aggressive readahead)
+     */
+    void advise_sequential() const {
+#ifndef _WIN32
+        if (data_ptr) madvise(const_cast<char*>(data_ptr), file_size, MADV_SEQUENTIAL);
+#endif
+    }
+    
+    const char* data() const { return data_ptr; }
+    size_t size() const { return file_size; }
+    bool is_open() const { return data_ptr != nullptr; }
+};
@@ -5,8 +5,11 @@
 #include <string>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
 #include "exchange.h"
 #include "latency_calculator.h"
+#include "binary_io.h"
+#include "mapped_file.h"
 
 /**
  * Edge in the network graph (connection between exchanges)
@@ -24,6 +27,23 @@ struct NetworkEdge {
           distance_km(dist), latency_ms(lat), medium(med) {}
 };
 
+/**
+ * On-disk header of a binary graph snapshot
+ * Followed by payload_size bytes of exchanges, edges and (optionally)
+ * the all-pairs latency and next-hop matrices
+ */
+struct GraphSnapshotHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t source_hash;       // Caller-defined tag (e.g. hash of exchanges.json)
+    uint64_t num_exchanges;
+    uint64_t num_edges;
+    uint64_t has_matrices;
+    uint64_t payload_size;
+    uint64_t payload_checksum;  // checksum64 of the payload
+};
+
 /**
  * Network Graph representing exchange connections
  */
@@ -33,13 +53,22 @@ private:
     std::vector<NetworkEdge> edges;
     std::map<std::string, int> exchange_index_map; // ID -> index
     
+    // All-pairs shortest paths (row-major N x N, empty until computed)
+    std::vector<double> latency_matrix;
+    std::vector<int32_t> next_hop_matrix;
+    
 public:
+    static constexpr uint64_t SNAPSHOT_MAGIC = 0x31485041524753ULL; // "SGRAPH1"
+    static constexpr uint32_t SNAPSHOT_VERSION = 1;
+    
     /**
      * Add an exchange to the network
      */
     void add_exchange(const Exchange& exchange) {
         exchange_index_map[exchange.id] = exchanges.size();
         exchanges.push_back(exchange);
+        latency_matrix.clear();
+        next_hop_matrix.clear();
     }
     
     /**
@@ -63,6 +92,61 @@ public:
                                   distance, latency, medium);
             }
         }
+        
+        compute_all_pairs();
+    }
+    
+    /**
+     * Floyd-Warshall all-pairs shortest paths over the current edges
+     * O(N^3) - for large topologies load a snapshot instead
+     */
+    void compute_all_pairs() {
+        const size_t n = exchanges.size();
+        const double inf = std::numeric_limits<double>::infinity();
+        latency_matrix.assign(n * n, inf);
+        next_hop_matrix.assign(n * n, -1);
+        
+        for (size_t i = 0; i < n; i++) {
+            latency_matrix[i * n + i] = 0.0;
+            next_hop_matrix[i * n + i] = static_cast<int32_t>(i);
+        }
+        
+        for (const auto& edge : edges) {
+            int from = get_exchange_index(edge.from_exchange);
+            int to = get_exchange_index(edge.to_exchange);
+            if (from < 0 || to < 0) continue;
+            
+            double& cell = latency_matrix[from * n + to];
+            if (edge.latency_ms < cell) {
+                cell = edge.latency_ms;
+                next_hop_matrix[from * n + to] = to;
+            }
+        }
+        
+        for (size_t k = 0; k < n; k++) {
+            const double* row_k = &latency_matrix[k * n];
+            for (size_t i = 0; i < n; i++) {
+                double d_ik = latency_matrix[i * n + k];
+                if (std::isinf(d_ik)) continue;
+                
+                double* row_i = &latency_matrix[i * n];
+                int32_t* hop_i = &next_hop_matrix[i * n];
+                for (size_t j = 0; j < n; j++) {
+                    double via = d_ik + row_k[j];
+                    if (via < row_i[j]) {
+                        row_i[j] = via;
+                        hop_i[j] = hop_i[k];
+                    }
+                }
+            }
+        }
+    }
+    
+    /**
+     * Has the all-pairs latency matrix been computed (or loaded)?
+     */
+    bool has_latency_matrix() const {
+        return !exchanges.empty() && latency_matrix.size() == exchanges.size() * exchanges.size();
     }
     
     /**
@@ -76,6 +160,36 @@ public:
         return nullptr;
     }
     
+    /**
+     * Get dense index of an exchange (-1 if unknown)
+     */
+    int get_exchange_index(const std::string& id) const {
+        auto it = exchange_index_map.find(id);
+        return (it != exchange_index_map.end()) ? it->second : -1;
+    }
+    
+    /**
+     * Shortest-path latency by dense index (requires the latency matrix)
+     */
+    double latency_between(int from, int to) const {
+        return latency_matrix[static_cast<size_t>(from) * exchanges.size() + to];
+    }
+    
+    /**
+     * Latencies from one exchange to every exchange, by dense index
+     * (requires the latency matrix)
+     */
+    const double* latency_row(int from) const {
+        return &latency_matrix[static_cast<size_t>(from) * exchanges.size()];
+    }
+    
+    /**
+     * Next hop on the shortest path from -> to (-1 if unreachable)
+     */
+    int next_hop(int from, int to) const {
+        return next_hop_matrix[static_cast<size_t>(from) * exchanges.size() + to];
+    }
+    
     /**
      * Get all exchanges
      */
@@ -91,13 +205,20 @@ public:
     }
     
     /**
-     * Dijkstra's shortest path algorithm
+     * Shortest path latency (O(1) lookup once the all-pairs matrix exists)
      * @param start_id Starting exchange ID
      * @param end_id Destination exchange ID
      * @return Total latency in milliseconds (or infinity if no path)
      */
     double shortest_path_latency(const std::string& start_id, const std::string& end_id) const {
-        // Simple implementation - for complete graph, direct path is shortest
+        if (has_latency_matrix()) {
+            int from = get_exchange_index(start_id);
+            int to = get_exchange_index(end_id);
+            if (from < 0 || to < 0) return std::numeric_limits<double>::infinity();
+            return latency_between(from, to);
+        }
+        
+        // No matrix yet - for complete graph, direct path is shortest
         for (const auto& edge : edges) {
             if (edge.from_exchange == start_id && edge.to_exchange == end_id) {
                 return edge.latency_ms;
@@ -159,6 +280,156 @@ public:
         return (count > 0) ? (total / count) : 0.0;
     }
     
+    /**
+     * Serialize exchanges, edges and the latency matrices to a binary snapshot
+     * @param path Output file
+     * @param source_hash Tag stored in the header (e.g. checksum of the source JSON)
+     * @return false if the file cannot be written
+     */
+    bool save_snapshot(const std::string& path, uint64_t source_hash = 0) const {
+        BinaryWriter writer;
+        GraphSnapshotHeader header{};
+        writer.write(header); // Back-patched below
+        
+        size_t payload_start = writer.size();
+        for (const auto& ex : exchanges) {
+            writer.write_string(ex.id);
+            writer.write_string(ex.name);
+            writer.write_string(ex.city);
+            writer.write(ex.latitude);
+            writer.write(ex.longitude);
+            writer.write(static_cast<uint32_t>(ex.type));
+            writer.write(ex.fee_percent);
+            writer.write(ex.min_profit_bps);
+            writer.write(static_cast<uint32_t>(ex.is_active));
+        }
+        
+        for (const auto& edge : edges) {
+            writer.write(static_cast<int32_t>(get_exchange_index(edge.from_exchange)));
+            writer.write(static_cast<int32_t>(get_exchange_index(edge.to_exchange)));
+            writer.write(edge.distance_km);
+            writer.write(edge.latency_ms);
+            writer.write(static_cast<uint32_t>(edge.medium));
+        }
+        
+        bool with_matrices = has_latency_matrix();
+        if (with_matrices) {
+            writer.align(sizeof(double));
+            writer.write_array(latency_matrix.data(), latency_matrix.size());
+            writer.write_array(next_hop_matrix.data(), next_hop_matrix.size());
+        }
+        
+        header.magic = SNAPSHOT_MAGIC;
+        header.version = SNAPSHOT_VERSION;
+        header.header_size = sizeof(GraphSnapshotHeader);
+        header.source_hash = source_hash;
+        header.num_exchanges = exchanges.size();
+        header.num_edges = edges.size();
+        header.has_matrices = with_matrices ? 1 : 0;
+        header.payload_size = writer.size() - payload_start;
+        header.payload_checksum = checksum64(writer.data() + payload_start, header.payload_size);
+        writer.patch(0, header);
+        
+        return writer.save(path);
+    }
+    
+    /**
+     * Replace the graph with a binary snapshot (mmap'd and validated in place)
+     * @param path Snapshot file
+     * @param expected_source_hash If non-zero, reject snapshots built from other data
+     * @return false (graph unchanged) on a missing, stale, corrupt or
+     *         version-mismatched file
+     */
+    bool load_snapshot(const std::string& path, uint64_t expected_source_hash = 0) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        
+        BinaryReader reader(file.data(), file.size());
+        GraphSnapshotHeader header;
+        if (!reader.read(header)) return false;
+        
+        if (header.magic != SNAPSHOT_MAGIC ||
+            header.version != SNAPSHOT_VERSION ||
+            header.header_size != sizeof(GraphSnapshotHeader) ||
+            header.payload_size != reader.remaining()) {
+            return false;
+        }
+        if (expected_source_hash != 0 && header.source_hash != expected_source_hash) {
+            return false;
+        }
+        if (checksum64(reader.current(), header.payload_size) != header.payload_checksum) {
+            return false;
+        }
+        
+        std::vector<Exchange> new_exchanges;
+        new_exchanges.reserve(header.num_exchanges);
+        for (uint64_t i = 0; i < header.num_exchanges; i++) {
+            Exchange ex;
+            uint32_t type = 0, active = 0;
+            reader.read_string(ex.id);
+            reader.read_string(ex.name);
+            reader.read_string(ex.city);
+            reader.read(ex.latitude);
+            reader.read(ex.longitude);
+            reader.read(type);
+            reader.read(ex.fee_percent);
+            reader.read(ex.min_profit_bps);
+            reader.read(active);
+            if (!reader.ok()) return false;
+            
+            ex.type = static_cast<ExchangeType>(type);
+            ex.is_active = active != 0;
+            new_exchanges.push_back(std::move(ex));
+        }
+        
+        std::vector<NetworkEdge> new_edges;
+        new_edges.reserve(header.num_edges);
+        for (uint64_t i = 0; i < header.num_edges; i++) {
+            int32_t from = 0, to = 0;
+            double distance = 0, latency = 0;
+            uint32_t medium = 0;
+            reader.read(from);
+            reader.read(to);
+            reader.read(distance);
+            reader.read(latency);
+            reader.read(medium);
+            if (!reader.ok() || from < 0 || to < 0 ||
+                from >= (int64_t)new_exchanges.size() || to >= (int64_t)new_exchanges.size()) {
+                return false;
+            }
+            
+            new_edges.emplace_back(new_exchanges[from].id, new_exchanges[to].id,
+                                   distance, latency, static_cast<TransmissionMedium>(medium));
+        }
+        
+        std::vector<double> new_latency;
+        std::vector<int32_t> new_next_hop;
+        if (header.has_matrices) {
+            size_t cells = new_exchanges.size() * new_exchanges.size();
+            new_latency.resize(cells);
+            new_next_hop.resize(cells);
+            reader.align(sizeof(double));
+            reader.read_array(new_latency.data(), cells);
+            reader.read_array(new_next_hop.data(), cells);
+            if (!reader.ok()) return false;
+        }
+        
+        exchanges = std::move(new_exchanges);
+        edges = std::move(new_edges);
+        latency_matrix = std::move(new_latency);
+        next_hop_matrix = std::move(new_next_hop);
+        
+        exchange_index_map.clear();
+        for (size_t i = 0; i < exchanges.size(); i++) {
+            exchange_index_map[exchanges[i].id] = static_cast<int>(i);
+        }
+        
+        if (!header.has_matrices) {
+            compute_all_pairs();
+        }
+        return true;
+    }
+    
     /**
      * Get statistics about the network
      */
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "aligned_allocator.h"
+#include "price.h"
+
+enum class BookSide : uint8_t {
+    BID = 0,
+    ASK = 1
+};
+
+enum class BookAction : uint8_t {
+    ADD = 0,      // New price level
+    MODIFY = 1,   // New size for an existing level
+    DELETE = 2    // Level removed
+};
+
+/**
+ * One price-level (L2) book update (32 bytes)
+ */
+struct BookMessage {
+    uint64_t timestamp;   // Nanoseconds since epoch
+    uint16_t symbol;      // Feed symbol handle
+    uint16_t venue;       // Feed venue handle
+    BookAction action;
+    BookSide side;
+    uint16_t reserved;
+    Ticks price;          // Level price in ticks of the symbol
+    double size;
+};
+static_assert(sizeof(BookMessage) == 32, "BookMessage must stay 32 bytes");
+
+/**
+ * One side of a book: up to MAX_LEVELS price levels, best first
+ * Prices (ticks) and sizes are parallel fixed arrays, so a side is four
+ * cache lines with no per-level allocation, level lookups are exact
+ * integer compares, and a level insert or delete is a short memmove.
+ */
+struct BookLevels {
+    static constexpr size_t MAX_LEVELS = 16;
+    
+    Ticks price[MAX_LEVELS] = {};
+    double size[MAX_LEVELS] = {};
+    uint32_t count = 0;
+    
+    bool empty() const { return count == 0; }
+    Ticks best_price() const { return count ? price[0] : NO_PRICE; }
+    double best_size() const { return count ? size[0] : 0.0; }
+    
+    /**
+     * Total size of the best `levels` levels
+     */
+    double depth(size_t levels = MAX_LEVELS) const {
+        double total = 0.0;
+        for (size_t i = 0; i < std::min<size_t>(levels, count); i++) total += size[i];
+        return total;
+    }
+};
+
+/**
+ * Fixed-depth price-level order book of one symbol on one venue
+ *
+ * Driven by add/modify/delete messages addressed by price. The book keeps
+ * the best MAX_LEVELS levels per side; levels pushed past the last slot by
+ * an insert are dropped, as with any top-N depth feed.
+ */
+class alignas(CACHE_LINE_SIZE) OrderBook {
+private:
+    BookLevels bids;                 // Descending prices
+    BookLevels asks;                 // Ascending prices
+    uint64_t sequence = 0;           // Messages applied
+    
+public:
+    static constexpr size_t MAX_LEVELS = BookLevels::MAX_LEVELS;
+    
+    /**
+     * Apply one message
+     * @return true if the side's best level (price or size) changed
+     */
+    bool apply(BookAction action, BookSide side, Ticks price, double size) {
+        sequence++;
+        BookLevels& levels = (side == BookSide::BID) ? bids : asks;
+        bool is_bid = side == BookSide::BID;
+        switch (action) {
+            case BookAction::ADD:    return add(levels, is_bid, price, size);
+            case BookAction::MODIFY: return modify(levels, is_bid, price, size);
+            case BookAction::DELETE: return remove(levels, is_bid, price);
+        }
+        return false;
+    }
+    
+    bool apply(const BookMessage& msg) {
+        return apply(msg.action, msg.side, msg.price, msg.size);
+    }
+    
+    void clear() {
+        bids.count = 0;
+        asks.count = 0;
+    }
+    
+    const BookLevels& get_bids() const { return bids; }
+    const BookLevels& get_asks() const { return asks; }
+    const BookLevels& levels(BookSide side) const { return (side == BookSide::BID) ? bids : asks; }
+    uint64_t messages_applied() const { return sequence; }
+    
+private:
+    /**
+     * First level at or behind `price` (bids descending, asks ascending)
+     */
+    static uint32_t find(const BookLevels& levels, bool is_bid, Ticks price) {
+        uint32_t i = 0;
+        if (is_bid) {
+            while (i < levels.count && levels.price[i] > price) i++;
+        } else {
+            while (i < levels.count && levels.price[i] < price) i++;
+        }
+        return i;
+    }
+    
+    /**
+     * Insert a level; an existing level at the same price takes the new size
+     */
+    static bool add(BookLevels& levels, bool is_bid, Ticks price, double size) {
+        uint32_t i = find(levels, is_bid, price);
+        if (i < levels.count && levels.price[i] == price) {
+            levels.size[i] = size;
+            return i == 0;
+        }
+        if (i >= MAX_LEVELS) return false;  // Worse than every kept level
+        
+        uint32_t last = std::min<uint32_t>(levels.count, MAX_LEVELS - 1);
+        for (uint32_t j = last; j > i; j--) {
+            levels.price[j] = levels.price[j - 1];
+            levels.size[j] = levels.size[j - 1];
+        }
+        levels.price[i] = price;
+        levels.size[i] = size;
+        levels.count = last + 1;
+        return i == 0;
+    }
+    
+    /**
+     * Resize a level (treated as an add if the level is unknown, e.g. it
+     * was beyond the kept depth when it was created)
+     */
+    static bool modify(BookLevels& levels, bool is_bid, Ticks price, double size) {
+        uint32_t i = find(levels, is_bid, price);
+        if (i < levels.count && levels.price[i] == price) {
+            levels.size[i] = size;
+            return i == 0;
+        }
+        return add(levels, is_bid, price, size);
+    }
+    
+    static bool remove(BookLevels& levels, bool is_bid, Ticks price) {
+        uint32_t i = find(levels, is_bid, price);
+        if (i >= levels.count || levels.price[i] != price) return false;
+        for (uint32_t j = i + 1; j < levels.count; j++) {
+            levels.price[j - 1] = levels.price[j];
+            levels.size[j - 1] = levels.size[j];
+        }
+        levels.count--;
+        return i == 0;
+    }
+};
+
+/**
+ * Books of every symbol x venue in one contiguous, cache-aligned array
+ * (same symbol-major order as QuoteStore, without the row padding)
+ */
+class OrderBookStore {
+private:
+    std::vector<OrderBook, AlignedAllocator<OrderBook>> books;
+    size_t num_symbols = 0;
+    size_t num_venues = 0;
+    
+public:
+    void resize(size_t symbols, size_t venues) {
+        num_symbols = symbols;
+        num_venues = venues;
+        books.assign(symbols * venues, OrderBook());
+    }
+    
+    void clear() {
+        books.clear();
+        num_symbols = 0;
+        num_venues = 0;
+    }
+    
+    bool enabled() const { return !books.empty(); }
+    
+    /**
+     * Books as one contiguous array (symbol * venues + venue), for checkpoints
+     */
+    OrderBook* data() { return books.data(); }
+    const OrderBook* data() const { return books.data(); }
+    size_t size() const { return books.size(); }
+    
+    OrderBook& at(size_t symbol, size_t venue) { return books[symbol * num_venues + venue]; }
+    const OrderBook& at(size_t symbol, size_t venue) const { return books[symbol * num_venues + venue]; }
+    
+    /**
+     * Apply a message to its book
+     * @return true if the book's best bid or ask changed
+     */
+    bool apply(const BookMessage& msg) {
+        if (msg.symbol >= num_symbols || msg.venue >= num_venues) return false;
+        return at(msg.symbol, msg.venue).apply(msg);
+    }
+};
+
+/**
+ * Result of sizing a cross-venue trade against book depth
+ */
+struct DepthFill {
+    double quantity = 0.0;       // Units bought at one venue and sold at the other
+    double buy_cost = 0.0;       // Sum of ask price x size taken
+    double sell_proceeds = 0.0;  // Sum of bid price x size hit
+    double profit = 0.0;         // Proceeds - cost - fees
+    uint32_t buy_levels = 0;     // Ask levels touched
+    uint32_t sell_levels = 0;    // Bid levels touched
+    
+    double buy_vwap() const { return quantity > 0.0 ? buy_cost / quantity : 0.0; }
+    double sell_vwap() const { return quantity > 0.0 ? sell_proceeds / quantity : 0.0; }
+};
+
+/**
+ * Size a buy-here / sell-there trade against depth
+ * Lifts the buy venue's asks and hits the sell venue's bids level by level
+ * while each marginal unit still nets a profit after fees.
+ * @param tick_size Price of one tick of the symbol
+ * @param fee_fraction Fee per side as a fraction of notional
+ * @param max_quantity Optional cap on the traded quantity
+ */
+inline DepthFill match_depth(const BookLevels& asks, const BookLevels& bids, double tick_size, double fee_fraction,
+                             double max_quantity = std::numeric_limits<double>::infinity()) {
+    DepthFill fill;
+    uint32_t i = 0, j = 0;
+    double ask_left = asks.count ? asks.size[0] : 0.0;
+    double bid_left = bids.count ? bids.size[0] : 0.0;
+    while (i < asks.count && j < bids.count && fill.quantity < max_quantity) {
+        if (bids.price[j] <= asks.price[i]) break;  // Exact: no gross edge left
+        double ask_price = static_cast<double>(asks.price[i]) * tick_size;
+        double bid_price = static_cast<double>(bids.price[j]) * tick_size;
+        double buy = ask_price * (1.0 + fee_fraction);
+        double sell = bid_price * (1.0 - fee_fraction);
+        if (sell <= buy) break;
+        
+        double q = std::min({ ask_left, bid_left, max_quantity - fill.quantity });
+        fill.quantity += q;
+        fill.buy_cost += q * ask_price;
+        fill.sell_proceeds += q * bid_price;
+        fill.profit += q * (sell - buy);
+        fill.buy_levels = i + 1;
+        fill.sell_levels = j + 1;
+        
+        ask_left -= q;
+        bid_left -= q;
+        if (ask_left <= 0.0 && ++i < asks.count) ask_left = asks.size[i];
+        if (bid_left <= 0.0 && ++j < bids.count) bid_left = bids.size[j];
+    }
+    return fill;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Philox4x32-10 counter-based random number generator
+ * (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11)
+ *
+ * A pure function of (counter, key): every draw is addressed by a
+ * 128-bit counter instead of advancing shared state, so any subset of
+ * draws can be generated in any order, on any thread, and still be
+ * bit-identical for a given key.
+ */
+struct Philox4x32 {
+    static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr uint32_t WEYL_0 = 0x9E3779B9; // Golden ratio
+    static constexpr uint32_t WEYL_1 = 0xBB67AE85; // sqrt(3) - 1
+    static constexpr int ROUNDS = 10;
+    
+    struct Block {
+        uint32_t v[4];
+    };
+    
+    /**
+     * Generate 4 random 32-bit words for a counter under a key
+     */
+    static Block generate(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3,
+                          uint32_t k0, uint32_t k1) {
+        for (int r = 0; r < ROUNDS; r++) {
+            uint64_t p0 = static_cast<uint64_t>(MULTIPLIER_0) * c0;
+            uint64_t p1 = static_cast<uint64_t>(MULTIPLIER_1) * c2;
+            uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+            uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+            
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+        return Block{ { c0, c1, c2, c3 } };
+    }
+    
+    /**
+     * Map a 32-bit word to a uniform double in (0, 1)
+     */
+    static double to_uniform(uint32_t x) {
+        return (static_cast<double>(x) + 0.5) * (1.0 / 4294967296.0);
+    }
+    
+    /**
+     * Box-Muller transform: two uniform words -> two independent N(0,1)
+     */
+    static void to_normal_pair(uint32_t a, uint32_t b, double& z0, double& z1) {
+        double radius = std::sqrt(-2.0 * std::log(to_uniform(a)));
+        double angle = 2.0 * M_PI * to_uniform(b);
+        z0 = radius * std::cos(angle);
+        z1 = radius * std::sin(angle);
+    }
+};
+
+/**
+ * Keyed draw addressing for the price feed
+ * Counter = (tick, symbol, venue, stream) so each (symbol, venue, tick)
+ * draw is independent of every other and of the order it is evaluated in
+ */
+class CounterRng {
+private:
+    uint32_t key0;
+    uint32_t key1;
+    
+public:
+    explicit CounterRng(uint64_t seed = 0)
+        : key0(static_cast<uint32_t>(seed)), key1(static_cast<uint32_t>(seed >> 32)) {}
+    
+    uint64_t seed() const {
+        return (static_cast<uint64_t>(key1) << 32) | key0;
+    }
+    
+    /**
+     * 4 random words for one (tick, symbol, venue, stream) address
+     * @param stream Small stream id (< 16) separating independent uses
+     */
+    Philox4x32::Block draw(uint64_t tick, uint32_t symbol, uint32_t venue, uint32_t stream) const {
+        return Philox4x32::generate(static_cast<uint32_t>(tick), static_cast<uint32_t>(tick >> 32),
+                                    symbol, (venue << 4) | (stream & 0xF), key0, key1);
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/**
+ * Fixed-point prices
+ *
+ * Quotes, books and history hold prices as integer multiples of their
+ * symbol's tick size. Compares are exact, arithmetic is deterministic and
+ * the grid is built in; prices become doubles only at the edges (display,
+ * file and wire formats, fee and P&L math).
+ */
+using Ticks = int64_t;
+
+// Ticks value of a cell that has not been quoted yet
+static constexpr Ticks NO_PRICE = 0;
+
+/**
+ * Nearest integer of a double (ties to even), |x| < 2^51
+ * Adds 1.5 * 2^52 so the rounded integer lands in the low mantissa bits:
+ * no libm call, and unlike a cast it compiles to plain vector adds and
+ * subtracts on SSE2/AVX2.
+ */
+inline int64_t round_to_int64(double x) {
+    const double magic = 6755399441055744.0;  // 2^52 + 2^51
+    double shifted = x + magic;
+    int64_t bits;
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    return bits - 0x4338000000000000LL;
+}
+
+/**
+ * Round-to-grid conversions for one tick size
+ */
+struct TickScale {
+    double tick_size = 0.01;
+    double inv_tick = 100.0;
+    
+    TickScale() = default;
+    explicit TickScale(double tick) : tick_size(tick), inv_tick(1.0 / tick) {}
+    
+    Ticks to_ticks(double price) const { return round_to_int64(price * inv_tick); }
+    Ticks floor_ticks(double price) const { return round_to_int64(std::floor(price * inv_tick)); }
+    Ticks ceil_ticks(double price) const { return round_to_int64(std::ceil(price * inv_tick)); }
+    double to_price(Ticks ticks) const { return static_cast<double>(ticks) * tick_size; }
+};
+
+/**
+ * Compact 32-bit offset from a reference price (records and history)
+ * @return false if the offset does not fit
+ */
+inline bool to_offset(Ticks price, Ticks reference, int32_t& offset) {
+    Ticks delta = price - reference;
+    if (delta < std::numeric_limits<int32_t>::min() || delta > std::numeric_limits<int32_t>::max()) return false;
+    offset = static_cast<int32_t>(delta);
+    return true;
+}
@@ -2,145 +2,765 @@
 
 #include <string>
 #include <map>
-#include <random>
+#include <optional>
+#include <memory>
 #include <chrono>
+#include <cmath>
 #include "exchange.h"
-
-/**
- * Represents a price quote at a specific time
- */
-struct PriceQuote {
-    std::string exchange_id;
-    std::string symbol;
-    double bid;           // Buy price
-    double ask;           // Sell price
-    double last;          // Last traded price
-    double volume;        // Trading volume
-    uint64_t timestamp;   // Milliseconds since epoch
-    
-    double spread() const { return ask - bid; }
-    double mid_price() const { return (bid + ask) / 2.0; }
-};
+#include "binary_io.h"
+#include "symbol.h"
+#include "quote_store.h"
+#include "change_set.h"
+#include "venue_health.h"
+#include "quote_history.h"
+#include "order_book.h"
+#include "philox.h"
+#include "price_kernels.h"
+#include "correlated_model.h"
+#include "thread_pool.h"
+#include "tsc_clock.h"
 
 /**
  * Mock price feed generator
  * Simulates realistic price movements with random walk + noise
+ * for a universe of symbols quoted on every venue
+ *
+ * All randomness comes from a counter-based generator addressed by
+ * (tick, symbol, venue), so a given seed reproduces the exact same price
+ * path no matter how the update is split across threads.
+ *
+ * Every write path (update_prices, apply_tick, apply_quote, book messages,
+ * injections) marks the cells it changed in a ChangeSet; consumers read
+ * get_changes() and the loop that owns the feed resets it once per tick.
+ * Each write also advances get_epoch(), so a consumer that only needs to
+ * know whether anything changed can compare one number.
+ *
+ * Every write path also marks its venue alive in a VenueHealth, and
+ * sequenced quotes (apply_quote with a per-venue sequence number) are
+ * checked for gaps and duplicates; refresh_venue_health() turns that into
+ * a mask of stale or gapped venues that scanners leave out.
  */
 class PriceFeed {
 private:
-    std::map<std::string, PriceQuote> current_prices;
-    std::mt19937 rng;
-    std::normal_distribution<double> price_change_dist;
-    std::normal_distribution<double> spread_dist;
+    QuoteStore quotes;                           // Symbol x venue quote matrix
+    ChangeSet changes;                           // Cells changed since the last clear_changes()
+    uint64_t epoch = 0;                          // Bumped by every write; never reset
+    VenueHealth health;                          // Sequence gaps and staleness per venue
+    AlignedVector<double> displacement;          // Per cell: transient relative price shift
+    std::vector<Ticks> displacement_ticks;       // Per cell: shift currently applied to bid/ask
+    size_t displaced_cells = 0;                  // Cells with a non-zero displacement
+    std::vector<uint8_t> book_driven;            // Per cell: quote mirrors a book fed by apply_book_message
+    size_t book_driven_cells = 0;
+    QuoteHistory history;                        // Recent quotes per cell (opt-in)
+    OrderBookStore books;                        // L2 depth per cell (opt-in)
+    size_t book_levels = 10;                     // Levels per side the simulation keeps filled
+    std::vector<SymbolSpec> symbols;             // Handle -> symbol parameters
+    std::vector<TickScale> scales;               // Handle -> tick grid
+    std::map<std::string, int> symbol_index_map; // Symbol name -> handle
+    std::vector<std::string> venue_ids;          // Handle -> exchange ID
+    std::map<std::string, int> venue_index_map;  // Exchange ID -> handle
+    std::vector<double> fair_value;              // Per-symbol common price (event-driven mode)
+    std::vector<uint64_t> symbol_events;         // Per-symbol apply_tick counter (RNG address)
+    CounterRng rng;
+    uint64_t tick = 0;                           // Update counter (RNG address)
+    std::unique_ptr<ThreadPool> workers;         // Null = single-threaded updates
+    
+    // Correlated GBM + jumps with cointegrated venues (empty factor = independent random walks)
+    CorrelationParams correlated;
+    CholeskyFactor correlation;
+    AlignedVector<double> basis;                 // Per cell: venue's relative deviation from fair value
+    std::vector<float> shocks;                   // Per symbol: independent N(0,1) of this update
+    std::vector<double> correlated_shocks;       // Per symbol: shocks after the Cholesky factor
+    std::vector<double> jumps;                   // Per symbol: log jump of this update (usually 0)
     
-    double base_price = 50000.0;  // Base price (e.g., BTC in USD)
-    double volatility = 0.0002;    // 0.02% per update
     double base_spread_bps = 2.0;  // 2 basis points spread
+    double spread_noise_bps = 0.3; // Std-dev of spread noise
+    double venue_reversion = 0.9;  // Fraction of a venue's deviation from fair value kept per tick
+    
+    // RNG streams (separate draws for the same symbol/venue/tick)
+    static constexpr uint32_t STREAM_INIT = 0;
+    static constexpr uint32_t STREAM_UPDATE = 1;
+    static constexpr uint32_t STREAM_EVENT = 3;          // 2 is used by TickArrivalModel
+    static constexpr uint32_t STREAM_BOOK = 4;
+    static constexpr uint32_t STREAM_JUMP = 6;           // 5 is used by DislocationEngine
+    static constexpr uint32_t GLOBAL_VENUE = 0x0FFFFFFF; // Venue slot for per-symbol draws
     
 public:
-    PriceFeed() : price_change_dist(0.0, 1.0), spread_dist(0.0, 0.3) {
-        auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-        rng.seed(static_cast<unsigned int>(seed));
-    }
+    PriceFeed() : rng(std::chrono::high_resolution_clock::now().time_since_epoch().count()) {}
     
     /**
-     * Initialize price feeds for all exchanges
+     * Deterministic feed: same seed + same calls = bit-identical prices
+     */
+    explicit PriceFeed(uint64_t seed) : rng(seed) {}
+    
+    /**
+     * Initialize a single-symbol feed for all exchanges
      */
     void initialize_feeds(const std::vector<Exchange>& exchanges, const std::string& symbol = "BTC/USD") {
-        for (const auto& ex : exchanges) {
-            PriceQuote quote;
-            quote.exchange_id = ex.id;
-            quote.symbol = symbol;
-            quote.last = base_price;
-            quote.volume = 1000.0 + (std::rand() % 9000);
-            quote.timestamp = get_current_timestamp();
-            
-            // Add small random offset per exchange (geographic factors)
-            double offset = (std::rand() % 100 - 50) * 0.1;
-            quote.last += offset;
-            
-            // Calculate bid/ask from mid price
-            double spread_bps = base_spread_bps + spread_dist(rng);
-            double spread_amount = quote.last * (spread_bps / 10000.0);
-            quote.bid = quote.last - spread_amount / 2.0;
-            quote.ask = quote.last + spread_amount / 2.0;
+        initialize_feeds(exchanges, std::vector<SymbolSpec>{ SymbolSpec(symbol, 50000.0, 0.0002, 0.01) });
+    }
+    
+    /**
+     * Initialize price feeds for every symbol of a universe on all exchanges
+     */
+    void initialize_feeds(const std::vector<Exchange>& exchanges, const std::vector<SymbolSpec>& universe) {
+        std::vector<std::string> venues;
+        for (const auto& ex : exchanges) venues.push_back(ex.id);
+        set_universe(universe, venues);
+        
+        uint64_t now = get_current_timestamp();
+        for (size_t s = 0; s < symbols.size(); s++) {
+            const SymbolSpec& spec = symbols[s];
+            fair_value[s] = spec.base_price;
+            quotes.tick_size[s] = spec.tick_size;
             
-            current_prices[ex.id] = quote;
+            for (size_t v = 0; v < exchanges.size(); v++) {
+                size_t i = quotes.index(s, v);
+                auto r = rng.draw(tick, s, v, STREAM_INIT);
+                
+                quotes.last[i] = spec.base_price;
+                quotes.volume[i] = 1000.0 + (r.v[0] % 9000);
+                quotes.ts[i] = now;
+                
+                // Add small random offset per exchange (geographic factors)
+                double offset = (static_cast<int>(r.v[1] % 100) - 50) * spec.base_price * 2e-6;
+                quotes.last[i] += offset;
+                
+                // Calculate bid/ask from mid price
+                double z0, z1;
+                Philox4x32::to_normal_pair(r.v[2], r.v[3], z0, z1);
+                double spread_bps = base_spread_bps + z0 * spread_noise_bps;
+                set_bid_ask(s, i, spread_bps);
+            }
+        }
+        mark_all_changed();
+        
+        if (!correlation.empty()) enable_correlated_model(correlated);
+        if (history.enabled()) {
+            history.resize(quotes.bid.size(), history.depth(), history.bucket_ns());
+            record_history(0, symbols.size());
+        }
+        if (books.enabled()) enable_order_books(book_levels);
+    }
+    
+    /**
+     * Keep a ring of recent quotes per cell so delayed views can be served
+     * @param depth Buckets kept per cell (rounded up to a power of two)
+     * @param bucket_ns Time resolution of lookups
+     */
+    void enable_history(size_t depth = 1024, uint64_t bucket_ns = 1000000) {
+        history.resize(quotes.bid.size(), depth, bucket_ns);
+        record_history(0, symbols.size());
+    }
+    
+    /**
+     * Maintain a fixed-depth L2 book per symbol/venue
+     * Simulated quote changes are turned into add/modify/delete messages
+     * that walk each book to the new top of book (deeper levels rest and
+     * churn); external depth arrives through apply_book_message().
+     * @param levels Levels per side the simulation keeps filled
+     */
+    void enable_order_books(size_t levels = 10) {
+        book_levels = std::min<size_t>(std::max<size_t>(levels, 1), OrderBook::MAX_LEVELS);
+        books.resize(symbols.size(), quotes.num_venues);
+        for (size_t s = 0; s < symbols.size(); s++) {
+            for (size_t v = 0; v < quotes.num_venues; v++) follow_book(s, v);
+        }
+        mark_all_changed();   // Depth now sizes every cell's opportunities
+    }
+    
+    void disable_order_books() {
+        books.clear();
+        mark_all_changed();
+    }
+    bool has_order_books() const { return books.enabled(); }
+    
+    /**
+     * L2 book of a symbol on a venue (requires enable_order_books)
+     */
+    const OrderBook& get_book(int symbol, int venue) const {
+        return books.at(symbol, venue);
+    }
+    
+    /**
+     * Apply an external L2 message; the cell's quote follows its book
+     * @return true if the top of book changed
+     */
+    bool apply_book_message(const BookMessage& msg) {
+        if (msg.symbol >= symbols.size() || msg.venue >= quotes.num_venues) return false;
+        if (!books.apply(msg)) return false;
+        health.touch(msg.venue);
+        
+        const OrderBook& book = books.at(msg.symbol, msg.venue);
+        size_t i = quotes.index(msg.symbol, msg.venue);
+        quotes.bid[i] = book.get_bids().best_price();
+        quotes.ask[i] = book.get_asks().best_price();
+        quotes.volume[i] = std::min(book.get_bids().best_size(), book.get_asks().best_size());
+        quotes.ts[i] = msg.timestamp;
+        displacement_ticks[i] = 0;  // Book-driven quotes are not displaced (see add_displacement)
+        if (!book_driven[i]) {
+            book_driven[i] = 1;
+            book_driven_cells++;
+        }
+        mark_changed(msg.symbol, msg.venue);
+        if (quotes.bid[i] > 0 && quotes.ask[i] > 0) {
+            quotes.last[i] = 0.5 * scales[msg.symbol].to_price(quotes.bid[i] + quotes.ask[i]);
         }
+        
+        if (history.enabled()) {
+            history.record(i, quotes.ts[i], quotes.bid[i], quotes.ask[i]);
+        }
+        return true;
     }
     
     /**
      * Update all prices (random walk simulation)
+     * Symbols are split across worker threads when set_worker_threads > 1
      */
     void update_prices() {
         uint64_t now = get_current_timestamp();
+        tick++;
         
-        // Global market movement (affects all exchanges similarly)
-        double global_change = price_change_dist(rng) * volatility * base_price;
+        if (!correlation.empty()) draw_correlated_shocks();
+        if (workers && symbols.size() > 1) {
+            workers->parallel_for(symbols.size(), [&](size_t begin, size_t end) {
+                update_symbol_range(begin, end, now);
+            });
+        } else {
+            update_symbol_range(0, symbols.size(), now);
+        }
+        release_book_driven();
+        mark_all_changed();
+        health.touch_all();
+    }
+    
+    /**
+     * Switch update_prices to the correlated multi-asset model
+     * Fair values follow correlated GBM with jumps; venues quote fair value
+     * x (1 + basis) with a mean-reverting basis. The correlation matrix is
+     * factored once here (O(N^3)); each update then costs one N^2/2
+     * triangular product on top of the per-venue work. Event-driven ticks
+     * (apply_tick) keep their own model.
+     * @param matrix Row-major symbols x symbols correlation matrix; empty =
+     *               the market/sector structure in params
+     * @return false if the matrix is not positive definite (model unchanged)
+     */
+    bool enable_correlated_model(const CorrelationParams& params, const std::vector<double>& matrix = {}) {
+        size_t n = symbols.size();
+        CholeskyFactor factor;
+        if (!factor.factor(matrix.empty() ? params.correlation_matrix(n) : matrix, n)) return false;
         
-        for (auto& [exchange_id, quote] : current_prices) {
-            // Individual exchange noise
-            double local_noise = price_change_dist(rng) * volatility * base_price * 0.3;
-            
-            // Update last price
-            quote.last += global_change + local_noise;
-            
-            // Ensure price stays positive
-            if (quote.last < 100.0) quote.last = 100.0;
-            
-            // Update bid/ask
-            double spread_bps = base_spread_bps + std::abs(spread_dist(rng));
-            double spread_amount = quote.last * (spread_bps / 10000.0);
-            quote.bid = quote.last - spread_amount / 2.0;
-            quote.ask = quote.last + spread_amount / 2.0;
-            
-            // Update timestamp
-            quote.timestamp = now;
-            
-            // Random volume fluctuation
-            quote.volume += (std::rand() % 200 - 100);
-            if (quote.volume < 100) quote.volume = 100;
+        correlated = params;
+        correlation = std::move(factor);
+        shocks.assign(n, 0.0f);
+        correlated_shocks.assign(n, 0.0);
+        jumps.assign(n, 0.0);
+        
+        // Start each venue's basis from where its quote stands now
+        basis.assign(quotes.last.size(), 0.0);
+        for (size_t s = 0; s < n; s++) {
+            for (size_t v = 0; v < quotes.num_venues; v++) {
+                size_t i = quotes.index(s, v);
+                basis[i] = (fair_value[s] > 0.0) ? quotes.last[i] / fair_value[s] - 1.0 : 0.0;
+            }
         }
+        return true;
+    }
+    
+    void disable_correlated_model() {
+        correlation.clear();
+        basis.clear();
+    }
+    
+    bool has_correlated_model() const { return !correlation.empty(); }
+    
+    /**
+     * Event-driven update of a single symbol/venue quote (one arrival of a
+     * TickArrivalModel)
+     * The symbol's fair value diffuses a little on every tick of any venue;
+     * the venue's quote jumps to it and keeps part of its own deviation, so
+     * venues that tick less often go stale relative to busier ones.
+     * @param timestamp Event time, ns since epoch
+     */
+    void apply_tick(int symbol, int venue, uint64_t timestamp) {
+        if (symbol < 0 || symbol >= (int)symbols.size() || venue < 0 || venue >= (int)quotes.num_venues) return;
+        const SymbolSpec& spec = symbols[symbol];
+        size_t i = quotes.index(symbol, venue);
+        
+        auto r = rng.draw(symbol_events[symbol]++, symbol, venue, STREAM_EVENT);
+        double fair_z, noise_z, spread_z, volume_z;
+        Philox4x32::to_normal_pair(r.v[0], r.v[1], fair_z, noise_z);
+        Philox4x32::to_normal_pair(r.v[2], r.v[3], spread_z, volume_z);
+        
+        // Spread the per-update volatility over the venues' ticks
+        double sigma = spec.volatility * spec.base_price;
+        double floor_price = spec.base_price * 0.002;
+        double deviation = quotes.last[i] - fair_value[symbol];
+        fair_value[symbol] = std::max(fair_value[symbol] + fair_z * sigma / std::sqrt((double)quotes.num_venues),
+                                      floor_price);
+        
+        quotes.last[i] = std::max(fair_value[symbol] + deviation * venue_reversion + noise_z * sigma * 0.3,
+                                  floor_price);
+        quotes.volume[i] = std::max(quotes.volume[i] + std::round(volume_z * 50.0), 100.0);
+        quotes.ts[i] = timestamp;
+        set_bid_ask(symbol, i, base_spread_bps + std::fabs(spread_z * spread_noise_bps));
+        release_book_driven(i);
+        mark_changed(symbol, venue);
+        health.touch(venue);
+        
+        if (history.enabled()) {
+            history.record(i, quotes.ts[i], quotes.bid[i], quotes.ask[i]);
+        }
+        if (books.enabled()) follow_book(symbol, venue);
+    }
+    
+    /**
+     * Overwrite a quote with an externally sourced one (e.g. recorded ticks)
+     * Prices are rounded to the symbol's tick grid; last is set to the mid.
+     * An active displacement shifts the quote on top. The cell is marked
+     * changed only if its bid, ask or volume moved.
+     * @param sequence Per-venue sequence number (0 = unsequenced); older
+     *                 than the venue's last one = duplicate, dropped
+     */
+    void apply_quote(int symbol, int venue, double bid, double ask, double volume, uint64_t timestamp,
+                     uint32_t sequence = 0) {
+        if (symbol < 0 || symbol >= (int)symbols.size() || venue < 0 || venue >= (int)quotes.num_venues) return;
+        if (!health.accept(venue, sequence)) return;
+        const TickScale& scale = scales[symbol];
+        size_t i = quotes.index(symbol, venue);
+        Ticks bid_ticks = scale.to_ticks(bid);
+        Ticks ask_ticks = scale.to_ticks(ask);
+        Ticks shift = (displacement[i] != 0.0) ? scale.to_ticks((bid + ask) * 0.5 * displacement[i]) : 0;
+        bid_ticks += shift;
+        ask_ticks += shift;
+        displacement_ticks[i] = shift;
+        if (bid_ticks != quotes.bid[i] || ask_ticks != quotes.ask[i] || volume != quotes.volume[i]) {
+            mark_changed(symbol, venue);
+        }
+        quotes.bid[i] = bid_ticks;
+        quotes.ask[i] = ask_ticks;
+        quotes.last[i] = (bid + ask) / 2.0;
+        quotes.volume[i] = volume;
+        quotes.ts[i] = timestamp;
+        release_book_driven(i);
+        
+        if (history.enabled()) {
+            history.record(i, timestamp, quotes.bid[i], quotes.ask[i]);
+        }
+        if (books.enabled()) follow_book(symbol, venue);
     }
     
     /**
      * Inject artificial arbitrage opportunity
      * Makes one exchange's price deviate significantly
      */
-    void inject_arbitrage_opportunity(const std::string& exchange_id, double deviation_percent) {
-        if (current_prices.count(exchange_id)) {
-            current_prices[exchange_id].last *= (1.0 + deviation_percent / 100.0);
-            
-            // Update bid/ask
-            double spread_bps = base_spread_bps;
-            double spread_amount = current_prices[exchange_id].last * (spread_bps / 10000.0);
-            current_prices[exchange_id].bid = current_prices[exchange_id].last - spread_amount / 2.0;
-            current_prices[exchange_id].ask = current_prices[exchange_id].last + spread_amount / 2.0;
+    void inject_arbitrage_opportunity(const std::string& exchange_id, double deviation_percent, int symbol = 0) {
+        int v = get_venue_handle(exchange_id);
+        if (v < 0 || symbol < 0 || symbol >= (int)symbols.size()) return;
+        
+        size_t i = quotes.index(symbol, v);
+        quotes.last[i] *= (1.0 + deviation_percent / 100.0);
+        quotes.ts[i] = get_current_timestamp();
+        
+        // Update bid/ask
+        set_bid_ask(symbol, i, base_spread_bps);
+        release_book_driven(i);
+        mark_changed(symbol, v);
+        health.touch(v);
+        
+        if (history.enabled()) {
+            history.record(i, quotes.ts[i], quotes.bid[i], quotes.ask[i]);
         }
+        if (books.enabled()) follow_book(symbol, v);
     }
     
     /**
-     * Get current price for an exchange
+     * Add to a cell's transient displacement (relative price shift)
+     * The displaced quote is bid/ask shifted by displacement x price, on top
+     * of whatever writes the cell (simulation, ticks, external quotes) until
+     * the displacement is taken away again. Quotes set by L2 book messages
+     * are not shifted (the displacement waits for the next write of another
+     * kind). Driven by a DislocationEngine.
      */
-    const PriceQuote* get_price(const std::string& exchange_id) const {
-        auto it = current_prices.find(exchange_id);
-        return (it != current_prices.end()) ? &it->second : nullptr;
+    void add_displacement(int symbol, int venue, double delta) {
+        if (symbol < 0 || symbol >= (int)symbols.size() || venue < 0 || venue >= (int)quotes.num_venues) return;
+        size_t i = quotes.index(symbol, venue);
+        double before = displacement[i];
+        double after = before + delta;
+        if (std::fabs(after) < 1e-12) after = 0.0;  // Rounding residue of cancelling shifts
+        displaced_cells += (after != 0.0) - (before != 0.0);
+        displacement[i] = after;
+        
+        if (quotes.bid[i] <= NO_PRICE || quotes.ask[i] <= NO_PRICE || book_driven[i]) return;
+        Ticks applied = displacement_ticks[i];
+        quotes.bid[i] -= applied;
+        quotes.ask[i] -= applied;
+        shift_quote(symbol, i);
+        if (displacement_ticks[i] == applied) return;
+        
+        mark_changed(symbol, venue);
+        if (history.enabled()) {
+            // The quote's own time stays; the shift itself happens now
+            history.record(i, get_current_timestamp(), quotes.bid[i], quotes.ask[i]);
+        }
+        if (books.enabled()) follow_book(symbol, venue);
     }
     
     /**
-     * Get all current prices
+     * Remove every displacement (quotes move back to their undisplaced prices)
      */
-    const std::map<std::string, PriceQuote>& get_all_prices() const {
-        return current_prices;
+    void clear_displacements() {
+        for (size_t s = 0; s < quotes.num_symbols && displaced_cells > 0; s++) {
+            for (size_t v = 0; v < quotes.num_venues; v++) {
+                size_t i = quotes.index(s, v);
+                if (displacement[i] != 0.0) add_displacement(s, v, -displacement[i]);
+            }
+        }
+    }
+    
+    double get_displacement(int symbol, int venue) const {
+        return displacement[quotes.index(symbol, venue)];
+    }
+    size_t num_displaced() const { return displaced_cells; }
+    
+    /**
+     * Get venue handle for an exchange (-1 if not in the feed)
+     */
+    int get_venue_handle(const std::string& exchange_id) const {
+        auto it = venue_index_map.find(exchange_id);
+        return (it != venue_index_map.end()) ? it->second : -1;
+    }
+    
+    /**
+     * Get exchange ID for a venue handle
+     */
+    const std::string& get_venue_id(int venue) const {
+        return venue_ids[venue];
+    }
+    
+    /**
+     * Get symbol handle by name (-1 if not in the universe)
+     */
+    int get_symbol_handle(const std::string& name) const {
+        auto it = symbol_index_map.find(name);
+        return (it != symbol_index_map.end()) ? it->second : -1;
     }
     
     /**
-     * Set volatility (0.0 to 1.0)
+     * Get symbol parameters for a handle
+     */
+    const SymbolSpec& get_symbol(int symbol) const {
+        return symbols[symbol];
+    }
+    
+    /**
+     * Get current price of a symbol on an exchange
+     */
+    std::optional<PriceQuote> get_price(const std::string& exchange_id, int symbol = 0) const {
+        int v = get_venue_handle(exchange_id);
+        if (v < 0 || symbol < 0 || symbol >= (int)symbols.size()) return std::nullopt;
+        return quotes.quote(symbol, v);
+    }
+    
+    /**
+     * Quote of a symbol on a venue as it stood at time `t` (ns since epoch)
+     * O(1); resolution is the history bucket width. Falls back to the live
+     * quote when history is disabled.
+     * @return nullopt if t predates the history window or the first quote
+     */
+    std::optional<PriceQuote> get_price_as_of(int symbol, int venue, uint64_t t) const {
+        if (symbol < 0 || symbol >= (int)symbols.size() || venue < 0 || venue >= (int)quotes.num_venues) {
+            return std::nullopt;
+        }
+        if (!history.enabled()) return quotes.quote(symbol, venue);
+        
+        size_t cell = quotes.index(symbol, venue);
+        const HistoryRecord* record = history.at(cell, t);
+        if (!record) return std::nullopt;
+        
+        PriceQuote q = quotes.quote(symbol, venue);
+        q.bid = history.price(cell, record->bid);
+        q.ask = history.price(cell, record->ask);
+        q.last = q.mid_price();
+        q.timestamp = record->timestamp;
+        return q;
+    }
+    
+    bool has_history() const { return history.enabled(); }
+    uint64_t history_horizon_ns() const { return history.horizon_ns(); }
+    uint64_t history_bucket_ns() const { return history.enabled() ? history.bucket_ns() : 0; }
+    
+    /**
+     * Current feed clock (ns since epoch)
+     */
+    uint64_t now_ns() const {
+        return get_current_timestamp();
+    }
+    
+    /**
+     * Get the quote matrix (indexed by symbol and venue handle)
+     */
+    const QuoteStore& get_quotes() const {
+        return quotes;
+    }
+    
+    /**
+     * Cells changed since the last clear_changes()
+     */
+    const ChangeSet& get_changes() const {
+        return changes;
+    }
+    
+    /**
+     * Write counter: advances whenever a quote, the venue mask or the
+     * universe changes and is never reset (clear_changes() does not touch
+     * it), so two reads that return the same epoch saw the same feed
+     */
+    uint64_t get_epoch() const {
+        return epoch;
+    }
+    
+    /**
+     * Start a new change epoch (call once every consumer has read get_changes())
+     */
+    void clear_changes() {
+        changes.clear();
+    }
+    
+    /**
+     * Rebuild the stale/gapped venue mask as of `now_ns` (call once per frame)
+     * Every cell of a venue that enters or leaves the mask is marked changed,
+     * so change-driven consumers rescan it.
+     * @return Venues that entered or left the mask
+     */
+    size_t refresh_venue_health(uint64_t now_ns) {
+        return health.refresh(now_ns, [this](size_t venue) {
+            for (size_t s = 0; s < symbols.size(); s++) mark_changed(s, venue);
+        });
+    }
+    
+    size_t refresh_venue_health() { return refresh_venue_health(get_current_timestamp()); }
+    
+    /**
+     * Record a sequence gap detected before quotes reached this feed
+     */
+    void report_venue_gap(int venue, uint64_t missed) {
+        if (venue >= 0) health.report_gap(static_cast<size_t>(venue), missed);
+    }
+    
+    /**
+     * True if a venue is stale or recently gapped (its quotes should not be traded on)
+     */
+    bool venue_masked(int venue) const {
+        return venue >= 0 && health.is_masked(static_cast<size_t>(venue));
+    }
+    
+    const VenueHealth& get_venue_health() const { return health; }
+    VenueHealth& get_venue_health() { return health; }
+    
+    /**
+     * Serialize everything a run continues from: universe, quotes,
+     * displacements, generator counters, the correlated model (with its
+     * factor) and order books
+     * Quote history and venue health describe the recent past rather than
+     * the state, and are rebuilt on restore.
+     */
+    void write_state(BinaryWriter& out) const {
+        out.write<uint64_t>(rng.seed());
+        out.write<uint64_t>(tick);
+        out.write<uint64_t>(symbols.size());
+        out.write<uint64_t>(venue_ids.size());
+        for (const auto& spec : symbols) {
+            out.write_string(spec.name);
+            out.write(spec.base_price);
+            out.write(spec.volatility);
+            out.write(spec.tick_size);
+        }
+        for (const auto& id : venue_ids) out.write_string(id);
+        out.write(base_spread_bps);
+        out.write(spread_noise_bps);
+        out.write(venue_reversion);
+        
+        size_t cells = quotes.bid.size();
+        out.write<uint64_t>(cells);
+        out.align(sizeof(double));
+        out.write_array(quotes.bid.data(), cells);
+        out.write_array(quotes.ask.data(), cells);
+        out.write_array(quotes.last.data(), cells);
+        out.write_array(quotes.volume.data(), cells);
+        out.write_array(quotes.ts.data(), cells);
+        out.write_array(quotes.tick_size.data(), symbols.size());
+        out.write_array(fair_value.data(), symbols.size());
+        out.write_array(symbol_events.data(), symbols.size());
+        out.write_array(displacement.data(), cells);
+        out.write_array(displacement_ticks.data(), cells);
+        
+        out.write<uint64_t>(correlation.empty() ? 0 : 1);
+        if (!correlation.empty()) {
+            out.write(correlated);
+            out.write_array(basis.data(), cells);
+            correlation.write_state(out);
+        }
+        
+        out.write<uint64_t>(book_levels);
+        out.write<uint64_t>(books.enabled() ? 1 : 0);
+        if (books.enabled()) out.write_array(books.data(), books.size());
+    }
+    
+    /**
+     * Replace the state with one written by write_state()
+     * Worker threads, history depth and venue health settings are kept;
+     * history is restarted from the restored quotes.
+     * @param time_shift_ns Added to every quote timestamp (moves a saved
+     *                      run to the current clock)
+     * @return false (feed unchanged) on malformed input
+     */
+    bool read_state(BinaryReader& in, uint64_t time_shift_ns = 0) {
+        PriceFeed parsed;
+        if (!parse_state(in, parsed, time_shift_ns)) return false;
+        adopt_state(std::move(parsed));
+        return true;
+    }
+    
+    /**
+     * First half of read_state(): parse a write_state() image into `out`
+     * without touching any live feed, so a caller restoring several
+     * sections can validate them all before committing any
+     * @return false (`out` unchanged) on malformed input
+     */
+    static bool parse_state(BinaryReader& in, PriceFeed& out, uint64_t time_shift_ns = 0) {
+        uint64_t seed = 0, saved_tick = 0, num_syms = 0, num_venues = 0;
+        in.read(seed);
+        in.read(saved_tick);
+        in.read(num_syms);
+        in.read(num_venues);
+        if (!in.ok() || num_syms > in.remaining() || num_venues > in.remaining()) return false;
+        
+        std::vector<SymbolSpec> universe(num_syms);
+        for (auto& spec : universe) {
+            in.read_string(spec.name);
+            in.read(spec.base_price);
+            in.read(spec.volatility);
+            in.read(spec.tick_size);
+        }
+        std::vector<std::string> venues(num_venues);
+        for (auto& id : venues) in.read_string(id);
+        if (!in.ok()) return false;
+        
+        PriceFeed next(seed);
+        next.set_universe(universe, venues);
+        next.tick = saved_tick;
+        in.read(next.base_spread_bps);
+        in.read(next.spread_noise_bps);
+        in.read(next.venue_reversion);
+        
+        uint64_t cells = 0;
+        if (!in.read(cells) || cells != next.quotes.bid.size()) return false;
+        in.align(sizeof(double));
+        in.read_array(next.quotes.bid.data(), cells);
+        in.read_array(next.quotes.ask.data(), cells);
+        in.read_array(next.quotes.last.data(), cells);
+        in.read_array(next.quotes.volume.data(), cells);
+        in.read_array(next.quotes.ts.data(), cells);
+        in.read_array(next.quotes.tick_size.data(), num_syms);
+        in.read_array(next.fair_value.data(), num_syms);
+        in.read_array(next.symbol_events.data(), num_syms);
+        in.read_array(next.displacement.data(), cells);
+        in.read_array(next.displacement_ticks.data(), cells);
+        
+        uint64_t has_correlation = 0;
+        if (!in.read(has_correlation)) return false;
+        if (has_correlation) {
+            in.read(next.correlated);
+            next.basis.resize(cells);
+            in.read_array(next.basis.data(), cells);
+            if (!next.correlation.read_state(in) || next.correlation.size() != num_syms) return false;
+            next.shocks.assign(num_syms, 0.0f);
+            next.correlated_shocks.assign(num_syms, 0.0);
+            next.jumps.assign(num_syms, 0.0);
+        }
+        
+        uint64_t levels = 0, has_books = 0;
+        in.read(levels);
+        in.read(has_books);
+        if (!in.ok() || levels < 1 || levels > OrderBook::MAX_LEVELS) return false;
+        next.book_levels = static_cast<size_t>(levels);
+        if (has_books) {
+            next.books.resize(num_syms, num_venues);
+            in.read_array(next.books.data(), next.books.size());
+            // Raw level arrays: a bad count would index past them on the next message
+            for (size_t b = 0; b < next.books.size(); b++) {
+                const OrderBook& book = next.books.data()[b];
+                if (book.get_bids().count > OrderBook::MAX_LEVELS || book.get_asks().count > OrderBook::MAX_LEVELS) {
+                    return false;
+                }
+            }
+        }
+        if (!in.ok()) return false;
+        
+        for (size_t i = 0; i < cells; i++) {
+            if (next.displacement[i] != 0.0) next.displaced_cells++;
+            if (next.quotes.ts[i] != 0) next.quotes.ts[i] += time_shift_ns;
+        }
+        out = std::move(next);
+        return true;
+    }
+    
+    /**
+     * Second half of read_state(): take over a feed filled by parse_state(),
+     * keeping this feed's runtime settings
+     */
+    void adopt_state(PriceFeed&& next) {
+        next.workers = std::move(workers);
+        next.health.set_stale_after_ns(health.get_stale_after_ns());
+        next.health.set_gap_hold_ns(health.get_gap_hold_ns());
+        bool with_history = history.enabled();
+        size_t history_depth = history.depth();
+        uint64_t history_bucket = history.bucket_ns();
+        uint64_t last_epoch = epoch;
+        *this = std::move(next);
+        epoch = last_epoch;   // Keeps counting up, so nothing cached before the restore matches
+        
+        if (with_history) enable_history(history_depth, history_bucket);
+        mark_all_changed();
+        health.touch_all();
+    }
+    
+    size_t num_symbols() const { return quotes.num_symbols; }
+    size_t num_venues() const { return quotes.num_venues; }
+    
+    /**
+     * Set volatility (0.0 to 1.0) for every symbol
      */
     void set_volatility(double vol) {
-        volatility = vol;
+        for (auto& spec : symbols) spec.volatility = vol;
+    }
+    
+    /**
+     * Set volatility of a single symbol
+     */
+    void set_symbol_volatility(int symbol, double vol) {
+        if (symbol >= 0 && symbol < (int)symbols.size()) symbols[symbol].volatility = vol;
+    }
+    
+    /**
+     * Number of threads used by update_prices (1 = calling thread only)
+     * Results are identical for any thread count
+     */
+    void set_worker_threads(size_t threads) {
+        workers = (threads > 1) ? std::make_unique<ThreadPool>(threads) : nullptr;
+    }
+    
+    /**
+     * Common price of a symbol that event-driven ticks revert towards
+     */
+    double get_fair_value(int symbol) const {
+        return fair_value[symbol];
     }
     
+    uint64_t get_seed() const { return rng.seed(); }
+    uint64_t get_tick() const { return tick; }
+    
     /**
      * Set base spread in basis points
      */
@@ -149,9 +769,279 @@ public:
     }
     
 private:
+    // Every write path goes through these, so the epoch cannot miss a change
+    void mark_changed(size_t symbol, size_t venue) {
+        changes.mark(symbol, venue);
+        epoch++;
+    }
+
+    void mark_all_changed() {
+        changes.mark_all();
+        epoch++;
+    }
+
+    /**
+     * Random-walk update of symbols [begin, end)
+     * Each draw is addressed by (tick, symbol, venue), so the split of the
+     * symbol range does not affect the result. Venue rows are processed in
+     * batches: Philox words, Box-Muller normals and the quote update are
+     * each one vectorizable pass over scratch arrays.
+     */
+    void update_symbol_range(size_t begin, size_t end, uint64_t now) {
+        const size_t B = PriceKernels::BATCH;
+        alignas(CACHE_LINE_SIZE) uint32_t r0[B], r1[B], r2[B], r3[B];
+        alignas(CACHE_LINE_SIZE) float noise_z[B], spread_z[B];
+        uint32_t k0 = static_cast<uint32_t>(rng.seed());
+        uint32_t k1 = static_cast<uint32_t>(rng.seed() >> 32);
+        
+        for (size_t s = begin; s < end; s++) {
+            const SymbolSpec& spec = symbols[s];
+            
+            // Global market movement (affects all exchanges similarly)
+            auto g = rng.draw(tick, s, GLOBAL_VENUE, STREAM_UPDATE);
+            double global_z, unused_z;
+            Philox4x32::to_normal_pair(g.v[0], g.v[1], global_z, unused_z);
+            
+            PriceKernels::RowParams params;
+            params.global_change = global_z * spec.volatility * spec.base_price;
+            params.noise_scale = spec.volatility * spec.base_price * 0.3; // Individual exchange noise
+            params.base_spread_bps = base_spread_bps;
+            params.spread_noise_bps = spread_noise_bps;
+            params.floor_price = spec.base_price * 0.002; // Ensure price stays positive
+            params.tick_size = spec.tick_size;
+            params.timestamp = now;
+            
+            PriceKernels::BasisRowParams basis_params{};
+            if (correlation.empty()) {
+                fair_value[s] = std::max(fair_value[s] + params.global_change, params.floor_price);
+            } else {
+                // Log-normal step on the correlated shock, plus this update's jump
+                double sigma = spec.volatility;
+                double log_step = correlated.drift - 0.5 * sigma * sigma + sigma * correlated_shocks[s] + jumps[s];
+                fair_value[s] = std::max(fair_value[s] * std::exp(log_step), params.floor_price);
+                basis_params.fair_value = fair_value[s];
+                basis_params.persistence = correlated.basis_persistence;
+                basis_params.basis_scale = correlated.basis_volatility;
+                basis_params.base_spread_bps = base_spread_bps;
+                basis_params.spread_noise_bps = spread_noise_bps;
+                basis_params.floor_price = params.floor_price;
+                basis_params.tick_size = spec.tick_size;
+                basis_params.timestamp = now;
+            }
+            
+            // Contiguous venue row of this symbol
+            size_t row = quotes.index(s, 0);
+            for (size_t v = 0; v < quotes.num_venues; v += B) {
+                size_t n = std::min(B, quotes.num_venues - v);
+                size_t i = row + v;
+                
+                PriceKernels::philox_batch(k0, k1, tick, s, v, STREAM_UPDATE, n, r0, r1, r2, r3);
+                PriceKernels::box_muller_batch(r0, r1, n, noise_z, spread_z);
+                if (correlation.empty()) {
+                    PriceKernels::random_walk_row(params, n, noise_z, spread_z, r2,
+                                                  &quotes.last[i], &quotes.bid[i], &quotes.ask[i],
+                                                  &quotes.volume[i], &quotes.ts[i]);
+                } else {
+                    PriceKernels::basis_row(basis_params, n, noise_z, spread_z, r2, &basis[i],
+                                            &quotes.last[i], &quotes.bid[i], &quotes.ask[i],
+                                            &quotes.volume[i], &quotes.ts[i]);
+                }
+            }
+            
+            // Re-apply transient dislocations over the fresh quotes
+            if (displaced_cells > 0) {
+                for (size_t v = 0; v < quotes.num_venues; v++) shift_quote(s, row + v);
+            }
+        }
+        
+        if (history.enabled()) record_history(begin, end);
+        if (books.enabled()) {
+            for (size_t s = begin; s < end; s++) {
+                for (size_t v = 0; v < quotes.num_venues; v++) follow_book(s, v);
+            }
+        }
+    }
+    
+    /**
+     * Independent shocks and jumps of every symbol, then the correlated
+     * shocks through the Cholesky factor
+     * Each symbol's draws are addressed by (tick, symbol), and each row of
+     * the product is summed the same way whatever the row split, so the
+     * result does not depend on the thread count.
+     */
+    void draw_correlated_shocks() {
+        auto draw = [this](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; s++) {
+                auto g = rng.draw(tick, s, GLOBAL_VENUE, STREAM_UPDATE);
+                double z, unused_z;
+                Philox4x32::to_normal_pair(g.v[0], g.v[1], z, unused_z);
+                shocks[s] = static_cast<float>(z);
+                
+                jumps[s] = 0.0;
+                if (g.v[2] * (1.0 / 4294967296.0) < correlated.jump_probability) {
+                    auto j = rng.draw(tick, s, GLOBAL_VENUE, STREAM_JUMP);
+                    double jump_z;
+                    Philox4x32::to_normal_pair(j.v[0], j.v[1], jump_z, unused_z);
+                    jumps[s] = correlated.jump_mean + correlated.jump_std * jump_z;
+                }
+            }
+        };
+        auto multiply = [this](size_t begin, size_t end) {
+            correlation.multiply(shocks.data(), correlated_shocks.data(), begin, end);
+        };
+        
+        size_t n = symbols.size();
+        if (workers && n > 1) {
+            workers->parallel_for(n, draw);
+            // Row i costs ~i: many small chunks keep the threads balanced
+            workers->parallel_for(n, workers->size() * 8, [&](size_t, size_t begin, size_t end) {
+                multiply(begin, end);
+            });
+        } else {
+            draw(0, n);
+            multiply(0, n);
+        }
+    }
+    
+    /**
+     * Size every per-cell structure for a universe, with empty quotes and
+     * generator counters at zero
+     */
+    void set_universe(const std::vector<SymbolSpec>& universe, const std::vector<std::string>& venues) {
+        symbols = universe;
+        quotes.resize(symbols.size(), venues.size());
+        changes.resize(symbols.size(), venues.size());
+        health.resize(venues.size());
+        displacement.assign(quotes.bid.size(), 0.0);
+        displacement_ticks.assign(quotes.bid.size(), 0);
+        displaced_cells = 0;
+        book_driven.assign(quotes.bid.size(), 0);
+        book_driven_cells = 0;
+        scales.clear();
+        for (const auto& spec : symbols) scales.push_back(spec.scale());
+        
+        symbol_index_map.clear();
+        for (size_t s = 0; s < symbols.size(); s++) {
+            symbol_index_map[symbols[s].name] = static_cast<int>(s);
+        }
+        
+        venue_ids = venues;
+        venue_index_map.clear();
+        for (size_t v = 0; v < venues.size(); v++) {
+            venue_index_map[venues[v]] = static_cast<int>(v);
+        }
+        
+        tick = 0;
+        symbol_events.assign(symbols.size(), 0);
+        fair_value.assign(symbols.size(), 0.0);
+    }
+    
+    /**
+     * Append the current quotes of symbols [begin, end) to the history ring
+     */
+    void record_history(size_t begin, size_t end) {
+        if (!history.enabled()) return;
+        for (size_t s = begin; s < end; s++) {
+            for (size_t v = 0; v < quotes.num_venues; v++) {
+                size_t i = quotes.index(s, v);
+                history.record(i, quotes.ts[i], quotes.bid[i], quotes.ask[i]);
+            }
+        }
+    }
+    
+    /**
+     * Walk a cell's book to its current quote with add/modify/delete messages
+     */
+    void follow_book(size_t symbol, size_t venue) {
+        OrderBook& book = books.at(symbol, venue);
+        size_t i = quotes.index(symbol, venue);
+        auto r = rng.draw(book.messages_applied(), symbol, venue, STREAM_BOOK);
+        follow_book_side(book, BookSide::BID, quotes.bid[i], -1, quotes.volume[i], r.v[0], r.v[1]);
+        follow_book_side(book, BookSide::ASK, quotes.ask[i], 1, quotes.volume[i], r.v[2], r.v[3]);
+    }
+    
+    /**
+     * Pull levels through the new top, set the top level, resize one resting
+     * level and refill the tail up to book_levels
+     * @param step Direction away from the top (-1 for bids, +1 for asks)
+     */
+    void follow_book_side(OrderBook& book, BookSide side, Ticks top, Ticks step, double top_size,
+                          uint32_t r0, uint32_t r1) {
+        const BookLevels& levels = book.levels(side);
+        bool is_bid = side == BookSide::BID;
+        if (top <= 0) {
+            while (!levels.empty()) book.apply(BookAction::DELETE, side, levels.price[0], 0.0);
+            return;
+        }
+        
+        while (!levels.empty() && (is_bid ? levels.price[0] > top : levels.price[0] < top)) {
+            book.apply(BookAction::DELETE, side, levels.price[0], 0.0);
+        }
+        bool same_top = !levels.empty() && levels.price[0] == top;
+        book.apply(same_top ? BookAction::MODIFY : BookAction::ADD, side, top, top_size);
+        
+        if (levels.count > 1) {
+            uint32_t k = 1 + r0 % (levels.count - 1);
+            double scale = 0.5 + (r1 >> 8) * (1.0 / (1 << 24));  // [0.5, 1.5)
+            book.apply(BookAction::MODIFY, side, levels.price[k], std::max(levels.size[k] * scale, 1.0));
+        }
+        
+        // Levels sit 1-3 ticks apart: fill holes left by a moving top,
+        // refill the tail and trim past book_levels
+        for (uint32_t k = 1; k < book_levels; k++) {
+            if (k < levels.count && (levels.price[k] - levels.price[k - 1]) * step <= 3) continue;
+            r1 = r1 * 1664525u + 1013904223u;
+            Ticks price = levels.price[k - 1] + step * static_cast<Ticks>(1 + (r1 >> 30) % 3);
+            if (price <= 0) break;
+            book.apply(BookAction::ADD, side, price, top_size * (0.5 + (r1 >> 8) * (2.0 / (1 << 24))));
+        }
+        while (levels.count > book_levels) {
+            book.apply(BookAction::DELETE, side, levels.price[levels.count - 1], 0.0);
+        }
+    }
+    
+    /**
+     * Derive a cell's bid/ask from its last price, snapped outward to whole ticks
+     */
+    void set_bid_ask(size_t symbol, size_t i, double spread_bps) {
+        const TickScale& scale = scales[symbol];
+        double spread_amount = quotes.last[i] * (spread_bps / 10000.0);
+        quotes.bid[i] = scale.floor_ticks(quotes.last[i] - spread_amount / 2.0);
+        quotes.ask[i] = scale.ceil_ticks(quotes.last[i] + spread_amount / 2.0);
+        shift_quote(symbol, i);
+    }
+    
+    /**
+     * A write other than a book message took over the cell's quote (its book
+     * now follows the quote again)
+     */
+    void release_book_driven(size_t i) {
+        if (!book_driven[i]) return;
+        book_driven[i] = 0;
+        book_driven_cells--;
+    }
+    
+    void release_book_driven() {
+        if (book_driven_cells == 0) return;
+        std::fill(book_driven.begin(), book_driven.end(), 0);
+        book_driven_cells = 0;
+    }
+    
+    /**
+     * Shift a freshly written, undisplaced bid/ask by the cell's displacement
+     */
+    void shift_quote(size_t symbol, size_t i) {
+        if (displacement[i] == 0.0) {
+            displacement_ticks[i] = 0;
+            return;
+        }
+        Ticks shift = scales[symbol].to_ticks(quotes.last[i] * displacement[i]);
+        quotes.bid[i] += shift;
+        quotes.ask[i] += shift;
+        displacement_ticks[i] = shift;
+    }
+    
     uint64_t get_current_timestamp() const {
-        return std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
+        return TscClock::now_ns();
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "philox.h"
+#include "price.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define LAS_RESTRICT __restrict
+#else
+#define LAS_RESTRICT __restrict__
+#endif
+
+/**
+ * Batch kernels for the price feed and scanner hot paths
+ *
+ * Every routine is a straight-line loop over contiguous arrays with no
+ * branches, calls or cross-lane dependencies, written so GCC/Clang/MSVC
+ * auto-vectorize it (SSE2 baseline, AVX2/AVX-512 with LAS_NATIVE_ARCH).
+ * Transcendentals use polynomial approximations instead of libm so the
+ * Box-Muller stage vectorizes too; accuracy is ~1e-7 relative, far below
+ * the noise being simulated. Philox has an explicit AVX2 path because
+ * compilers do not map its 32x32->64 multiplies onto vpmuludq.
+ */
+class PriceKernels {
+public:
+    // Lanes processed per batch (scratch arrays live on the stack)
+    static constexpr size_t BATCH = 256;
+    
+    /**
+     * Philox4x32-10 for `n` consecutive venues of one (tick, symbol, stream)
+     * Produces the same words as CounterRng::draw(tick, symbol, venue_begin + i, stream)
+     */
+    static void philox_batch(uint32_t k0, uint32_t k1, uint64_t tick, uint32_t symbol,
+                             uint32_t venue_begin, uint32_t stream, size_t n,
+                             uint32_t* LAS_RESTRICT out0, uint32_t* LAS_RESTRICT out1,
+                             uint32_t* LAS_RESTRICT out2, uint32_t* LAS_RESTRICT out3) {
+        const uint32_t tick_lo = static_cast<uint32_t>(tick);
+        const uint32_t tick_hi = static_cast<uint32_t>(tick >> 32);
+        size_t i = 0;
+
+#if defined(__AVX2__)
+        // Compilers widen the 32x32->64 products to 64-bit multiplies, so the
+        // 8-lane version spells out the even/odd vpmuludq split explicitly
+        const __m256i mul0 = _mm256_set1_epi64x(Philox4x32::MULTIPLIER_0);
+        const __m256i mul1 = _mm256_set1_epi64x(Philox4x32::MULTIPLIER_1);
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i keys0[Philox4x32::ROUNDS], keys1[Philox4x32::ROUNDS];
+        for (int r = 0; r < Philox4x32::ROUNDS; r++) {
+            keys0[r] = _mm256_set1_epi32(static_cast<int>(k0 + r * Philox4x32::WEYL_0));
+            keys1[r] = _mm256_set1_epi32(static_cast<int>(k1 + r * Philox4x32::WEYL_1));
+        }
+        
+        for (; i + 8 <= n; i += 8) {
+            __m256i c0 = _mm256_set1_epi32(static_cast<int>(tick_lo));
+            __m256i c1 = _mm256_set1_epi32(static_cast<int>(tick_hi));
+            __m256i c2 = _mm256_set1_epi32(static_cast<int>(symbol));
+            __m256i venue = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(venue_begin + i)), lane);
+            __m256i c3 = _mm256_or_si256(_mm256_slli_epi32(venue, 4), _mm256_set1_epi32(static_cast<int>(stream & 0xF)));
+            
+            for (int r = 0; r < Philox4x32::ROUNDS; r++) {
+                __m256i hi0, lo0, hi1, lo1;
+                mul_hi_lo_8x32(c0, mul0, hi0, lo0);
+                mul_hi_lo_8x32(c2, mul1, hi1, lo1);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), keys0[r]);
+                c1 = lo1;
+                c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), keys1[r]);
+                c3 = lo0;
+            }
+            
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out0 + i), c0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out1 + i), c1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out2 + i), c2);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out3 + i), c3);
+        }
+#endif
+
+        for (; i < n; i++) {
+            auto block = Philox4x32::generate(tick_lo, tick_hi, symbol,
+                                              ((venue_begin + static_cast<uint32_t>(i)) << 4) | (stream & 0xF),
+                                              k0, k1);
+            out0[i] = block.v[0];
+            out1[i] = block.v[1];
+            out2[i] = block.v[2];
+            out3[i] = block.v[3];
+        }
+    }
+    
+    /**
+     * Natural log for x > 0 (normal, finite), single precision
+     * x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then an odd series in
+     * t = (m - 1) / (m + 1)
+     */
+    static float fast_log(float x) {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        
+        // Shift so the mantissa lands in [sqrt(1/2), sqrt(2)) instead of [1, 2)
+        const uint32_t offset = 0x3f3504f3u; // bits of sqrt(1/2)
+        uint32_t shifted = bits - offset;
+        int32_t exponent = static_cast<int32_t>(shifted) >> 23;
+        uint32_t mant_bits = (shifted & 0x007fffffu) + offset;
+        float m;
+        std::memcpy(&m, &mant_bits, sizeof(m));
+        
+        float t = (m - 1.0f) / (m + 1.0f);
+        float t2 = t * t;
+        float series = 1.0f + t2 * (1.0f / 3 + t2 * (1.0f / 5 + t2 * (1.0f / 7 + t2 * (1.0f / 9))));
+        return 2.0f * t * series + static_cast<float>(exponent) * 0.69314718f;
+    }
+    
+    /**
+     * sin(2*pi*u) and cos(2*pi*u) for u in [0, 1), single precision
+     * Folds to |angle| <= pi/2, then Taylor series to x^11 / x^12
+     */
+    static void fast_sincos_2pi(float u, float& s, float& c) {
+        float f = u - std::floor(u + 0.5f);                // [-0.5, 0.5]
+        float sign = (f < 0.0f) ? -1.0f : 1.0f;
+        bool fold = std::fabs(f) > 0.25f;
+        float g = fold ? (sign * 0.5f - f) : f;            // [-0.25, 0.25]
+        float cos_sign = fold ? -1.0f : 1.0f;
+        
+        float x = g * static_cast<float>(2.0 * M_PI);
+        float x2 = x * x;
+        s = x * (1.0f + x2 * (-1.0f / 6 + x2 * (1.0f / 120 + x2 * (-1.0f / 5040 + x2 * (1.0f / 362880 +
+            x2 * (-1.0f / 39916800))))));
+        c = cos_sign * (1.0f + x2 * (-1.0f / 2 + x2 * (1.0f / 24 + x2 * (-1.0f / 720 + x2 * (1.0f / 40320 +
+            x2 * (-1.0f / 3628800 + x2 * (1.0f / 479001600)))))));
+    }
+    
+    /**
+     * Box-Muller over arrays: (a[i], b[i]) uniform words -> (z0[i], z1[i]) ~ N(0,1)
+     * Single precision: twice the lanes per vector, and 24-bit normals are
+     * plenty for simulated noise
+     */
+    static void box_muller_batch(const uint32_t* LAS_RESTRICT a, const uint32_t* LAS_RESTRICT b, size_t n,
+                                 float* LAS_RESTRICT z0, float* LAS_RESTRICT z1) {
+        const float scale = 1.0f / 16777216.0f; // 2^-24
+        for (size_t i = 0; i < n; i++) {
+            // Top 24 bits convert to float exactly (signed int conversion vectorizes everywhere)
+            float ua = (static_cast<float>(static_cast<int32_t>(a[i] >> 8)) + 0.5f) * scale;
+            float ub = (static_cast<float>(static_cast<int32_t>(b[i] >> 8)) + 0.5f) * scale;
+            float radius = std::sqrt(-2.0f * fast_log(ua));
+            float s, c;
+            fast_sincos_2pi(ub, s, c);
+            z0[i] = radius * c;
+            z1[i] = radius * s;
+        }
+    }
+    
+    /**
+     * Parameters of one symbol row update
+     */
+    struct RowParams {
+        double global_change;    // Common move added to every venue
+        double noise_scale;      // Std-dev of per-venue noise (price units)
+        double base_spread_bps;
+        double spread_noise_bps;
+        double floor_price;
+        double tick_size;
+        uint64_t timestamp;
+    };
+    
+    /**
+     * Random-walk update of one contiguous venue row
+     * The latent price stays continuous; bid/ask are snapped outward to
+     * whole ticks
+     * @param noise_z Per-venue N(0,1) for the price move
+     * @param spread_z Per-venue N(0,1) for the spread
+     * @param volume_bits Per-venue random words for the volume walk
+     */
+    static void random_walk_row(const RowParams& p, size_t n,
+                                const float* LAS_RESTRICT noise_z, const float* LAS_RESTRICT spread_z,
+                                const uint32_t* LAS_RESTRICT volume_bits,
+                                double* LAS_RESTRICT last, Ticks* LAS_RESTRICT bid, Ticks* LAS_RESTRICT ask,
+                                double* LAS_RESTRICT volume, uint64_t* LAS_RESTRICT ts) {
+        // Hoist parameters into locals so the loop body only touches the arrays
+        const double global_change = p.global_change;
+        const double noise_scale = p.noise_scale;
+        const double base_spread_bps = p.base_spread_bps;
+        const double spread_noise_bps = p.spread_noise_bps;
+        const double floor_price = p.floor_price;
+        const double inv_tick = 1.0 / p.tick_size;
+        const uint64_t timestamp = p.timestamp;
+        const double half_bps = 0.5 / 10000.0;
+        
+        for (size_t v = 0; v < n; v++) {
+            double price = last[v] + global_change + noise_z[v] * noise_scale;
+            price = std::max(price, floor_price);
+            last[v] = price;
+            
+            double spread_bps = base_spread_bps + std::fabs(spread_z[v] * spread_noise_bps);
+            double half_spread = price * spread_bps * half_bps;
+            bid[v] = round_to_int64(std::floor((price - half_spread) * inv_tick));
+            ask[v] = round_to_int64(std::ceil((price + half_spread) * inv_tick));
+            
+            ts[v] = timestamp;
+            
+            // Uniform integer step in [-100, 100) via multiply-high (no vector divide)
+            int32_t step = static_cast<int32_t>((static_cast<uint64_t>(volume_bits[v]) * 200) >> 32) - 100;
+            volume[v] = std::max(volume[v] + static_cast<double>(step), 100.0);
+        }
+    }
+    
+    /**
+     * Parameters of one symbol row of the cointegrated venue model
+     */
+    struct BasisRowParams {
+        double fair_value;       // Symbol's common price this update
+        double persistence;      // Fraction of each venue's basis kept
+        double basis_scale;      // Std-dev of basis shocks
+        double base_spread_bps;
+        double spread_noise_bps;
+        double floor_price;
+        double tick_size;
+        uint64_t timestamp;
+    };
+    
+    /**
+     * Cointegrated update of one contiguous venue row
+     * Each venue's basis (relative deviation from fair value) decays and
+     * takes a fresh shock; the venue quotes fair value x (1 + basis)
+     * @param noise_z Per-venue N(0,1) for the basis shock
+     */
+    static void basis_row(const BasisRowParams& p, size_t n,
+                          const float* LAS_RESTRICT noise_z, const float* LAS_RESTRICT spread_z,
+                          const uint32_t* LAS_RESTRICT volume_bits, double* LAS_RESTRICT basis,
+                          double* LAS_RESTRICT last, Ticks* LAS_RESTRICT bid, Ticks* LAS_RESTRICT ask,
+                          double* LAS_RESTRICT volume, uint64_t* LAS_RESTRICT ts) {
+        const double fair_value = p.fair_value;
+        const double persistence = p.persistence;
+        const double basis_scale = p.basis_scale;
+        const double base_spread_bps = p.base_spread_bps;
+        const double spread_noise_bps = p.spread_noise_bps;
+        const double floor_price = p.floor_price;
+        const double inv_tick = 1.0 / p.tick_size;
+        const uint64_t timestamp = p.timestamp;
+        const double half_bps = 0.5 / 10000.0;
+        
+        for (size_t v = 0; v < n; v++) {
+            double b = basis[v] * persistence + noise_z[v] * basis_scale;
+            basis[v] = b;
+            double price = std::max(fair_value * (1.0 + b), floor_price);
+            last[v] = price;
+            
+            double spread_bps = base_spread_bps + std::fabs(spread_z[v] * spread_noise_bps);
+            double half_spread = price * spread_bps * half_bps;
+            bid[v] = round_to_int64(std::floor((price - half_spread) * inv_tick));
+            ask[v] = round_to_int64(std::ceil((price + half_spread) * inv_tick));
+            
+            ts[v] = timestamp;
+            
+            int32_t step = static_cast<int32_t>((static_cast<uint64_t>(volume_bits[v]) * 200) >> 32) - 100;
+            volume[v] = std::max(volume[v] + static_cast<double>(step), 100.0);
+        }
+    }
+    
+    /**
+     * Arbitrage screen of one buy venue against a row of sell venues
+     * margin[j] > 0 where selling at j clears `min_bid` (the buy ask marked
+     * up by fees, slippage and minimum profit) and, if `latency_ms` is
+     * given, round-trips inside `window_ms`. Prices are ticks as doubles;
+     * venues without a quote carry -inf bids. Only survivors are worth
+     * building an opportunity record for.
+     * A min of two differences (minpd) keeps the loop in doubles: SSE2
+     * has no cheap way to narrow double compare masks to bytes.
+     */
+    static void screen_sells(double min_bid, const double* LAS_RESTRICT bid, const double* LAS_RESTRICT latency_ms,
+                             double window_ms, size_t n, double* LAS_RESTRICT margin) {
+        if (latency_ms) {
+            for (size_t j = 0; j < n; j++) margin[j] = std::min(bid[j] - min_bid, window_ms - latency_ms[j] * 2.0);
+        } else {
+            for (size_t j = 0; j < n; j++) margin[j] = bid[j] - min_bid;
+        }
+    }
+    
+    /**
+     * Dot product of two double arrays
+     * Eight running partial sums (fixed order, so results are reproducible)
+     * let the loop vectorize without reassociating floating point
+     */
+    static double dot(const double* LAS_RESTRICT a, const double* LAS_RESTRICT b, size_t n) {
+        double acc[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (size_t k = 0; k < 8; k++) acc[k] += a[i + k] * b[i + k];
+        }
+        double sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        for (; i < n; i++) sum += a[i] * b[i];
+        return sum;
+    }
+    
+    /**
+     * y[i] = L[i][0..i] . x for rows [begin, end) of a row-major lower
+     * triangle with row pitch `stride`
+     * Each row keeps eight lane sums over whole 8-column blocks, reduced
+     * in a fixed order, so a row's result does not depend on which rows
+     * it is computed with. With AVX2/FMA, rows go four at a time so every
+     * load of x feeds four rows (x stays in L1; the factor streams through
+     * once); compilers turn the portable version into gathers instead.
+     */
+    static void lower_matvec(const float* LAS_RESTRICT lower, size_t stride, const float* LAS_RESTRICT x,
+                             size_t begin, size_t end, double* LAS_RESTRICT y) {
+        size_t i = begin;
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; i + 4 <= end; i += 4) {
+            const float* r0 = lower + i * stride;
+            const float* r1 = r0 + stride;
+            const float* r2 = r1 + stride;
+            const float* r3 = r2 + stride;
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+            __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+            size_t shared = (i + 1) / 8 * 8;  // Whole blocks every row of the group covers
+            for (size_t c = 0; c < shared; c += 8) {
+                __m256 xc = _mm256_loadu_ps(x + c);
+                a0 = _mm256_fmadd_ps(_mm256_loadu_ps(r0 + c), xc, a0);
+                a1 = _mm256_fmadd_ps(_mm256_loadu_ps(r1 + c), xc, a1);
+                a2 = _mm256_fmadd_ps(_mm256_loadu_ps(r2 + c), xc, a2);
+                a3 = _mm256_fmadd_ps(_mm256_loadu_ps(r3 + c), xc, a3);
+            }
+            y[i] = finish_row(r0, x, a0, shared, i + 1);
+            y[i + 1] = finish_row(r1, x, a1, shared, i + 2);
+            y[i + 2] = finish_row(r2, x, a2, shared, i + 3);
+            y[i + 3] = finish_row(r3, x, a3, shared, i + 4);
+        }
+        for (; i < end; i++) {
+            y[i] = finish_row(lower + i * stride, x, _mm256_setzero_ps(), 0, i + 1);
+        }
+#else
+        for (; i < end; i++) {
+            const float* r = lower + i * stride;
+            size_t length = i + 1;
+            float acc[8] = {};
+            size_t c = 0;
+            for (; c + 8 <= length; c += 8) {
+                for (size_t k = 0; k < 8; k++) acc[k] += r[c + k] * x[c + k];
+            }
+            y[i] = reduce_lanes(acc, r, x, c, length);
+        }
+#endif
+    }
+    
+private:
+    /**
+     * Sum eight lane partials in a fixed order, then add the ragged tail
+     */
+    static double reduce_lanes(const float* acc, const float* row, const float* x, size_t from, size_t length) {
+        double sum = ((double(acc[0]) + acc[1]) + (double(acc[2]) + acc[3])) +
+                     ((double(acc[4]) + acc[5]) + (double(acc[6]) + acc[7]));
+        for (size_t c = from; c < length; c++) sum += double(row[c]) * x[c];
+        return sum;
+    }
+    
+#if defined(__AVX2__) && defined(__FMA__)
+    /**
+     * Continue a row's lane sums over whole blocks [from, length), then reduce
+     */
+    static double finish_row(const float* row, const float* x, __m256 acc, size_t from, size_t length) {
+        size_t c = from;
+        for (; c + 8 <= length; c += 8) {
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(row + c), _mm256_loadu_ps(x + c), acc);
+        }
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, acc);
+        return reduce_lanes(lanes, row, x, c, length);
+    }
+#endif
+    
+#if defined(__AVX2__)
+    /**
+     * 8 lanes of 32x32 -> 64 multiply split into high and low words
+     * vpmuludq only multiplies even lanes, so odd lanes are shifted down first
+     */
+    static void mul_hi_lo_8x32(__m256i a, __m256i multiplier, __m256i& hi, __m256i& lo) {
+        __m256i even = _mm256_mul_epu32(a, multiplier);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), multiplier);
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+#endif
+};
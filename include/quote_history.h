@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "aligned_allocator.h"
+#include "price.h"
+
+/**
+ * One historical top-of-book sample (16 bytes, four per cache line)
+ * Prices are 32-bit tick offsets from the cell's reference price.
+ */
+struct HistoryRecord {
+    uint64_t timestamp;   // Timestamp of the quote this slot holds
+    int32_t bid;
+    int32_t ask;
+};
+
+/**
+ * Per-cell time-bucketed ring buffer of recent quotes
+ *
+ * Time (ns) is cut into fixed buckets of `bucket_ns`; every cell owns `depth`
+ * slots indexed by bucket % depth. Writing a quote carries the previous
+ * quote forward into every bucket skipped since the last write, so each
+ * slot always holds "the latest quote as of the end of that bucket" and a
+ * lookup at time t is a single slot read, O(1), at bucket resolution.
+ * Carry-forward costs at most `depth` copies per write, amortized O(1) per
+ * elapsed bucket.
+ *
+ * A cell's reference price is its first bid; a quote too far from it for
+ * a 32-bit offset restarts the cell's history at the new price.
+ */
+class QuoteHistory {
+private:
+    AlignedVector<HistoryRecord> records;   // cell * depth + slot
+    std::vector<Ticks> reference;            // Per cell: price offsets are taken from
+    std::vector<uint64_t> first_bucket;      // Oldest bucket ever written per cell
+    std::vector<uint64_t> head_bucket;       // Newest bucket written per cell
+    std::vector<uint8_t> written;            // Cell has at least one record
+    size_t num_cells = 0;
+    size_t ring_depth = 0;                   // Power of two
+    size_t mask = 0;
+    uint64_t bucket_width = 1;
+    
+public:
+    /**
+     * Allocate `depth` buckets (rounded up to a power of two) for every cell
+     */
+    void resize(size_t cells, size_t depth, uint64_t bucket_ns) {
+        ring_depth = 1;
+        while (ring_depth < depth) ring_depth <<= 1;
+        mask = ring_depth - 1;
+        num_cells = cells;
+        bucket_width = std::max<uint64_t>(1, bucket_ns);
+        
+        records.assign(cells * ring_depth, HistoryRecord{ 0, 0, 0 });
+        reference.assign(cells, NO_PRICE);
+        first_bucket.assign(cells, 0);
+        head_bucket.assign(cells, 0);
+        written.assign(cells, 0);
+    }
+    
+    /**
+     * Drop all samples but keep the allocation
+     */
+    void clear() {
+        std::fill(written.begin(), written.end(), 0);
+    }
+    
+    /**
+     * Append a quote for one cell
+     * Timestamps older than the cell's newest bucket are folded into it
+     */
+    void record(size_t cell, uint64_t timestamp, Ticks bid, Ticks ask) {
+        HistoryRecord* ring = &records[cell * ring_depth];
+        uint64_t bucket = timestamp / bucket_width;
+        HistoryRecord sample{ timestamp, 0, 0 };
+        bool fits = written[cell] && to_offset(bid, reference[cell], sample.bid) &&
+                    to_offset(ask, reference[cell], sample.ask);
+        
+        if (!fits) {
+            written[cell] = 1;
+            reference[cell] = bid;
+            to_offset(ask, bid, sample.ask);  // Only a garbage spread of 2^31+ ticks fails
+            first_bucket[cell] = bucket;
+            head_bucket[cell] = bucket;
+            ring[bucket & mask] = sample;
+            return;
+        }
+        
+        uint64_t head = head_bucket[cell];
+        if (bucket > head) {
+            // Carry the previous quote through the skipped buckets (only the
+            // last depth - 1 of them can still be addressed)
+            HistoryRecord previous = ring[head & mask];
+            uint64_t from = std::max<uint64_t>(head + 1, bucket - std::min<uint64_t>(bucket, ring_depth - 1));
+            for (uint64_t b = from; b < bucket; b++) {
+                ring[b & mask] = previous;
+            }
+            head_bucket[cell] = bucket;
+            ring[bucket & mask] = sample;
+        } else {
+            ring[head & mask] = sample;
+        }
+    }
+    
+    /**
+     * Price of a record's tick offset
+     */
+    Ticks price(size_t cell, int32_t offset) const {
+        return reference[cell] + offset;
+    }
+    
+    /**
+     * Latest quote of a cell as of time t (bucket resolution)
+     * @return nullptr if the cell had no quote yet at t or t is older than the ring
+     */
+    const HistoryRecord* at(size_t cell, uint64_t t) const {
+        if (cell >= num_cells || !written[cell]) return nullptr;
+        uint64_t bucket = t / bucket_width;
+        uint64_t head = head_bucket[cell];
+        const HistoryRecord* ring = &records[cell * ring_depth];
+        
+        if (bucket >= head) return &ring[head & mask];
+        if (bucket < first_bucket[cell] || head - bucket >= ring_depth) return nullptr;
+        return &ring[bucket & mask];
+    }
+    
+    bool enabled() const { return ring_depth > 0; }
+    size_t depth() const { return ring_depth; }
+    uint64_t bucket_ns() const { return bucket_width; }
+    
+    /**
+     * How far back lookups can reach (ns)
+     */
+    uint64_t horizon_ns() const { return (ring_depth > 0) ? (ring_depth - 1) * bucket_width : 0; }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "aligned_allocator.h"
+#include "price.h"
+
+/**
+ * Represents a price quote at a specific time
+ * Lightweight value view of one cell of the QuoteStore; prices stay in
+ * ticks until displayed
+ */
+struct PriceQuote {
+    int symbol;           // Symbol handle in the owning PriceFeed
+    int venue;            // Venue handle in the owning PriceFeed
+    Ticks bid;            // Buy price (ticks)
+    Ticks ask;            // Sell price (ticks)
+    double tick_size;     // Price of one tick
+    double last;          // Last traded price
+    double volume;        // Trading volume
+    uint64_t timestamp;   // Nanoseconds since epoch (TscClock)
+    
+    // Display prices
+    double bid_price() const { return static_cast<double>(bid) * tick_size; }
+    double ask_price() const { return static_cast<double>(ask) * tick_size; }
+    double spread() const { return static_cast<double>(ask - bid) * tick_size; }
+    double mid_price() const { return static_cast<double>(bid + ask) * 0.5 * tick_size; }
+};
+
+/**
+ * Struct-of-arrays symbol x venue quote matrix
+ * Each field lives in its own cache-aligned column. Within a column the
+ * venues of one symbol form a contiguous row, padded to a whole number of
+ * cache lines so every row starts aligned:
+ *   cell(symbol, venue) = symbol * stride + venue
+ */
+struct QuoteStore {
+    AlignedVector<Ticks> bid;
+    AlignedVector<Ticks> ask;
+    AlignedVector<double> last;
+    AlignedVector<double> volume;
+    AlignedVector<uint64_t> ts;
+    std::vector<double> tick_size;  // Per symbol: price of one tick
+    
+    size_t num_symbols = 0;
+    size_t num_venues = 0;
+    size_t stride = 0;  // Row pitch in elements (>= num_venues)
+    
+    /**
+     * Resize to a symbols x venues matrix (all cells zeroed)
+     */
+    void resize(size_t symbols, size_t venues) {
+        const size_t per_line = CACHE_LINE_SIZE / sizeof(double);
+        num_symbols = symbols;
+        num_venues = venues;
+        stride = (venues + per_line - 1) / per_line * per_line;
+        
+        size_t cells = symbols * stride;
+        bid.assign(cells, NO_PRICE);
+        ask.assign(cells, NO_PRICE);
+        last.assign(cells, 0.0);
+        volume.assign(cells, 0.0);
+        ts.assign(cells, 0);
+        tick_size.assign(symbols, 0.01);
+    }
+    
+    size_t index(int symbol, int venue) const {
+        return static_cast<size_t>(symbol) * stride + venue;
+    }
+    
+    /**
+     * Gather one cell's columns into a PriceQuote
+     */
+    PriceQuote quote(int symbol, int venue) const {
+        size_t i = index(symbol, venue);
+        PriceQuote q;
+        q.symbol = symbol;
+        q.venue = venue;
+        q.bid = bid[i];
+        q.ask = ask[i];
+        q.tick_size = tick_size[symbol];
+        q.last = last[i];
+        q.volume = volume[i];
+        q.timestamp = ts[i];
+        return q;
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Named read-write shared memory segment
+ * POSIX shm objects live in /dev/shm on Linux; on Windows the segment is a
+ * pagefile-backed mapping in the session's Local\ namespace. The creator
+ * owns the name and removes it on close (POSIX); attached processes keep
+ * their mapping until they close it themselves.
+ */
+class SharedMemory {
+private:
+    char* data_ptr = nullptr;
+    size_t segment_size = 0;
+    std::string segment_name;
+    bool owner = false;
+#ifdef _WIN32
+    HANDLE mapping_handle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+public:
+    SharedMemory() = default;
+    ~SharedMemory() { close(); }
+    
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+    
+    /**
+     * Create (or replace) a zero-filled segment of `size` bytes
+     * @param name Segment name without a leading slash, e.g. "las_quotes"
+     */
+    bool create(const std::string& name, size_t size) {
+        close();
+        if (size == 0) return false;
+#ifdef _WIN32
+        std::string path = "Local\\" + name;
+        mapping_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+                                            static_cast<DWORD>(size & 0xFFFFFFFFu), path.c_str());
+        if (!mapping_handle) return false;
+        data_ptr = static_cast<char*>(MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+#else
+        std::string path = "/" + name;
+        shm_unlink(path.c_str()); // Replace a segment left by a crashed publisher
+        fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return false;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            fd = -1;
+            shm_unlink(path.c_str());
+            return false;
+        }
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        data_ptr = (ptr == MAP_FAILED) ? nullptr : static_cast<char*>(ptr);
+#endif
+        segment_name = name;
+        segment_size = size;
+        owner = true;
+        if (!data_ptr) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * Attach to an existing segment (read-write: consumers publish their
+     * read position through it)
+     */
+    bool open(const std::string& name) {
+        close();
+#ifdef _WIN32
+        std::string path = "Local\\" + name;
+        mapping_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path.c_str());
+        if (!mapping_handle) return false;
+        data_ptr = static_cast<char*>(MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (data_ptr) {
+            MEMORY_BASIC_INFORMATION info;
+            if (VirtualQuery(data_ptr, &info, sizeof(info))) segment_size = info.RegionSize;
+        }
+#else
+        std::string path = "/" + name;
+        fd = shm_open(path.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close();
+            return false;
+        }
+        segment_size = static_cast<size_t>(st.st_size);
+        void* ptr = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        data_ptr = (ptr == MAP_FAILED) ? nullptr : static_cast<char*>(ptr);
+#endif
+        segment_name = name;
+        if (!data_ptr) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * Unmap; the creator also removes the name
+     */
+    void close() {
+#ifdef _WIN32
+        if (data_ptr) UnmapViewOfFile(data_ptr);
+        if (mapping_handle) CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+#else
+        if (data_ptr) munmap(data_ptr, segment_size);
+        if (fd >= 0) ::close(fd);
+        if (owner) shm_unlink(("/" + segment_name).c_str());
+        fd = -1;
+#endif
+        data_ptr = nullptr;
+        segment_size = 0;
+        segment_name.clear();
+        owner = false;
+    }
+    
+    char* data() const { return data_ptr; }
+    size_t size() const { return segment_size; }
+    bool is_open() const { return data_ptr != nullptr; }
+    bool is_owner() const { return owner; }
+    const std::string& name() const { return segment_name; }
+};
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <new>
+#include <cstdint>
+#include <cstring>
+#include "shared_memory.h"
+#include "binary_io.h"
+#include "aligned_allocator.h"
+
+/**
+ * One quote slot in the shared-memory ring (48 bytes)
+ */
+struct ShmQuote {
+    uint64_t send_ns;     // Publisher's monotonic clock at publish (see monotonic_ns)
+    uint64_t timestamp;   // Quote time, nanoseconds since epoch
+    uint16_t symbol;      // Index into the ring's symbol table
+    uint16_t venue;       // Index into the ring's venue table
+    float volume;
+    double bid;
+    double ask;
+    uint32_t sequence;    // Per-venue sequence number (dropped quotes leave gaps)
+    uint32_t reserved;
+};
+static_assert(sizeof(ShmQuote) == 48, "ShmQuote must stay 48 bytes");
+
+/**
+ * Control block at the start of the segment
+ * Layout: header | symbol names | venue names | slots (64-aligned)
+ * The publisher owns head/dropped/closed and the consumer owns tail; each
+ * side's counters sit on their own cache line. The magic is stored last,
+ * so a consumer that sees it also sees a fully initialized segment.
+ */
+struct ShmRingHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t slot_size;
+    uint32_t num_symbols;
+    uint32_t num_venues;
+    uint32_t reserved;
+    uint64_t capacity;                           // Slots (power of two)
+    uint64_t names_offset;
+    uint64_t names_size;
+    uint64_t names_checksum;
+    uint64_t slots_offset;
+    
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head;  // Next slot to write
+    std::atomic<uint64_t> dropped;                        // Quotes lost to a full ring
+    std::atomic<uint32_t> closed;                         // Publisher finished
+    
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail;  // Next slot to read
+};
+
+constexpr uint64_t SHM_RING_MAGIC = 0x31474E4952534CULL; // "LSRING1"
+constexpr uint32_t SHM_RING_VERSION = 3;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared-memory ring needs address-free 64-bit atomics");
+
+/**
+ * Clock shared by publisher and consumer processes
+ * steady_clock is CLOCK_MONOTONIC on Linux and QueryPerformanceCounter on
+ * Windows, both system-wide, so cross-process differences are latencies.
+ */
+inline uint64_t monotonic_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Writer side of a shared-memory quote ring
+ *
+ * Mimics a multicast feed on one box: publish() never blocks. If the
+ * consumer falls a full ring behind (or none is attached) the quote is
+ * dropped and counted, as a slow multicast receiver would lose packets.
+ */
+class ShmQuotePublisher {
+private:
+    SharedMemory segment;
+    ShmRingHeader* header = nullptr;
+    ShmQuote* slots = nullptr;
+    uint64_t mask = 0;
+    uint64_t cached_tail = 0;
+    std::vector<uint32_t> venue_sequence;   // Last sequence number assigned per venue
+    
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    
+    ~ShmQuotePublisher() { close(); }
+    
+    /**
+     * Create the segment (replacing a stale one of the same name)
+     * @param capacity Slots, rounded up to a power of two
+     */
+    bool create(const std::string& name, size_t capacity,
+                const std::vector<std::string>& symbols, const std::vector<std::string>& venues) {
+        close();
+        if (symbols.size() > UINT16_MAX + 1u || venues.size() > UINT16_MAX + 1u) return false;
+        uint64_t n = 2;
+        while (n < capacity) n <<= 1;
+        
+        BinaryWriter names;
+        for (const auto& symbol : symbols) names.write_string(symbol);
+        for (const auto& venue : venues) names.write_string(venue);
+        
+        uint64_t names_offset = (sizeof(ShmRingHeader) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        uint64_t slots_offset = (names_offset + names.size() + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        if (!segment.create(name, slots_offset + n * sizeof(ShmQuote))) return false;
+        
+        header = new (segment.data()) ShmRingHeader();
+        header->version = SHM_RING_VERSION;
+        header->header_size = sizeof(ShmRingHeader);
+        header->slot_size = sizeof(ShmQuote);
+        header->num_symbols = static_cast<uint32_t>(symbols.size());
+        header->num_venues = static_cast<uint32_t>(venues.size());
+        header->capacity = n;
+        header->names_offset = names_offset;
+        header->names_size = names.size();
+        header->names_checksum = checksum64(names.data(), names.size());
+        header->slots_offset = slots_offset;
+        std::memcpy(segment.data() + names_offset, names.data(), names.size());
+        
+        slots = reinterpret_cast<ShmQuote*>(segment.data() + slots_offset);
+        mask = n - 1;
+        cached_tail = 0;
+        venue_sequence.assign(venues.size(), 0);
+        header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Mark the stream finished and remove the segment name
+     * (attached consumers keep their mapping and drain what is left)
+     */
+    void close() {
+        if (header) header->closed.store(1, std::memory_order_release);
+        header = nullptr;
+        slots = nullptr;
+        segment.close();
+    }
+    
+    /**
+     * Append one quote
+     * @param sequence Per-venue sequence number; 0 = number it here. A
+     *                 dropped quote still uses its number, so the consumer
+     *                 sees the gap.
+     * @return false if the ring was full and the quote was dropped
+     */
+    bool publish(uint16_t symbol, uint16_t venue, double bid, double ask, double volume, uint64_t timestamp,
+                 uint32_t sequence = 0) {
+        if (sequence == 0 && venue < venue_sequence.size()) sequence = ++venue_sequence[venue];
+        uint64_t h = header->head.load(std::memory_order_relaxed);
+        if (h - cached_tail > mask) {
+            cached_tail = header->tail.load(std::memory_order_acquire);
+            if (h - cached_tail > mask) {
+                header->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        ShmQuote& slot = slots[h & mask];
+        slot.timestamp = timestamp;
+        slot.symbol = symbol;
+        slot.venue = venue;
+        slot.volume = static_cast<float>(volume);
+        slot.bid = bid;
+        slot.ask = ask;
+        slot.sequence = sequence;
+        slot.reserved = 0;
+        slot.send_ns = monotonic_ns();
+        header->head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * PriceFeed-compatible sink (TickReplay, SimulatedFeedSource)
+     */
+    void apply_quote(int symbol, int venue, double bid, double ask, double volume, uint64_t timestamp,
+                     uint32_t sequence = 0) {
+        publish(static_cast<uint16_t>(symbol), static_cast<uint16_t>(venue), bid, ask, volume, timestamp, sequence);
+    }
+    
+    bool is_open() const { return header != nullptr; }
+    uint64_t published() const { return header ? header->head.load(std::memory_order_relaxed) : 0; }
+    uint64_t dropped() const { return header ? header->dropped.load(std::memory_order_relaxed) : 0; }
+    size_t capacity() const { return static_cast<size_t>(mask + 1); }
+};
+
+/**
+ * Reader side of a shared-memory quote ring
+ *
+ * consume() hands out references into the mapped slots, so quotes go from
+ * the publisher's stores straight into the consumer's PriceFeed with no
+ * intermediate copy. Slots are released with a single tail store per
+ * batch. One consumer per ring.
+ */
+class ShmQuoteConsumer {
+private:
+    SharedMemory segment;
+    const ShmRingHeader* header = nullptr;
+    std::atomic<uint64_t>* tail = nullptr;
+    const ShmQuote* slots = nullptr;
+    uint64_t mask = 0;
+    std::vector<std::string> symbol_names;
+    std::vector<std::string> venue_names;
+    std::vector<int> symbol_handles;   // Ring symbol index -> feed symbol handle (-1 = skip)
+    std::vector<int> venue_handles;    // Ring venue index -> feed venue handle (-1 = skip)
+    uint64_t consumed = 0;
+    uint64_t skipped = 0;
+    uint64_t batch_oldest_send_ns = 0;
+    
+public:
+    /**
+     * Attach to a publisher's ring
+     * @param skip_backlog Start at the newest quote instead of whatever
+     *                     queued up before this consumer attached
+     * @return false if the segment is missing, not yet initialized or
+     *         from an incompatible version
+     */
+    bool open(const std::string& name, bool skip_backlog = true) {
+        close();
+        if (!segment.open(name) || segment.size() < sizeof(ShmRingHeader)) {
+            close();
+            return false;
+        }
+        
+        const ShmRingHeader* h = reinterpret_cast<const ShmRingHeader*>(segment.data());
+        if (h->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC ||
+            h->version != SHM_RING_VERSION ||
+            h->header_size != sizeof(ShmRingHeader) ||
+            h->slot_size != sizeof(ShmQuote) ||
+            h->capacity == 0 || (h->capacity & (h->capacity - 1)) != 0 ||
+            h->names_offset + h->names_size > h->slots_offset ||
+            h->slots_offset + h->capacity * sizeof(ShmQuote) > segment.size()) {
+            close();
+            return false;
+        }
+        
+        BinaryReader names(segment.data() + h->names_offset, h->names_size);
+        std::vector<std::string> symbols(h->num_symbols), venues(h->num_venues);
+        for (auto& symbol : symbols) names.read_string(symbol);
+        for (auto& venue : venues) names.read_string(venue);
+        if (!names.ok() || names.remaining() != 0 ||
+            checksum64(segment.data() + h->names_offset, h->names_size) != h->names_checksum) {
+            close();
+            return false;
+        }
+        
+        header = h;
+        tail = &reinterpret_cast<ShmRingHeader*>(segment.data())->tail;
+        slots = reinterpret_cast<const ShmQuote*>(segment.data() + h->slots_offset);
+        mask = h->capacity - 1;
+        symbol_names = std::move(symbols);
+        venue_names = std::move(venues);
+        symbol_handles.assign(symbol_names.size(), -1);
+        venue_handles.assign(venue_names.size(), -1);
+        if (skip_backlog) {
+            tail->store(header->head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+        return true;
+    }
+    
+    void close() {
+        segment.close();
+        header = nullptr;
+        tail = nullptr;
+        slots = nullptr;
+        symbol_names.clear();
+        venue_names.clear();
+        symbol_handles.clear();
+        venue_handles.clear();
+        consumed = 0;
+        skipped = 0;
+    }
+    
+    /**
+     * Resolve the ring's symbol and venue names against a feed
+     * @return Number of ring symbols the feed quotes
+     */
+    template <typename Feed>
+    size_t bind(const Feed& feed) {
+        size_t matched = 0;
+        for (size_t i = 0; i < symbol_names.size(); i++) {
+            symbol_handles[i] = feed.get_symbol_handle(symbol_names[i]);
+            if (symbol_handles[i] >= 0) matched++;
+        }
+        for (size_t i = 0; i < venue_names.size(); i++) {
+            venue_handles[i] = feed.get_venue_handle(venue_names[i]);
+        }
+        return matched;
+    }
+    
+    /**
+     * Hand up to `max_quotes` queued quotes to fn(const ShmQuote&), reading
+     * them in place, then release their slots
+     * @return Quotes consumed
+     */
+    template <typename Fn>
+    size_t consume(Fn&& fn, size_t max_quotes = SIZE_MAX) {
+        if (!header) return 0;
+        uint64_t t = tail->load(std::memory_order_relaxed);
+        uint64_t available = header->head.load(std::memory_order_acquire) - t;
+        size_t n = (available < max_quotes) ? static_cast<size_t>(available) : max_quotes;
+        for (size_t i = 0; i < n; i++) {
+            fn(slots[(t + i) & mask]);
+        }
+        if (n > 0) tail->store(t + n, std::memory_order_release);
+        consumed += n;
+        return n;
+    }
+    
+    /**
+     * Apply queued quotes to a bound feed (or any apply_quote sink)
+     * @return Quotes consumed (applied or skipped)
+     */
+    template <typename Sink>
+    size_t drain_into(Sink& sink, size_t max_quotes = SIZE_MAX) {
+        uint64_t oldest = 0;
+        size_t n = consume([&](const ShmQuote& q) {
+            if (oldest == 0) oldest = q.send_ns;
+            int symbol = (q.symbol < symbol_handles.size()) ? symbol_handles[q.symbol] : -1;
+            int venue = (q.venue < venue_handles.size()) ? venue_handles[q.venue] : -1;
+            if (symbol < 0 || venue < 0) {
+                skipped++;
+                return;
+            }
+            sink.apply_quote(symbol, venue, q.bid, q.ask, q.volume, q.timestamp, q.sequence);
+        }, max_quotes);
+        if (n > 0) batch_oldest_send_ns = oldest;
+        return n;
+    }
+    
+    /**
+     * True once the publisher closed the stream and every quote was read
+     */
+    bool finished() const {
+        return header && header->closed.load(std::memory_order_acquire) &&
+               tail->load(std::memory_order_relaxed) == header->head.load(std::memory_order_acquire);
+    }
+    
+    bool is_open() const { return header != nullptr; }
+    const std::vector<std::string>& symbols() const { return symbol_names; }
+    const std::vector<std::string>& venues() const { return venue_names; }
+    size_t queued() const {
+        return header ? static_cast<size_t>(header->head.load(std::memory_order_acquire) -
+                                            tail->load(std::memory_order_relaxed)) : 0;
+    }
+    size_t capacity() const { return static_cast<size_t>(mask + 1); }
+    uint64_t quotes_consumed() const { return consumed; }
+    uint64_t quotes_skipped() const { return skipped; }
+    uint64_t publisher_dropped() const { return header ? header->dropped.load(std::memory_order_relaxed) : 0; }
+    
+    /**
+     * Publish time of the first quote of the last non-empty drain_into()
+     * batch (monotonic_ns clock) - its age is the batch's worst latency
+     */
+    uint64_t last_batch_oldest_send_ns() const { return batch_oldest_send_ns; }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "aligned_allocator.h"
+
+/**
+ * Bounded lock-free single-producer / single-consumer ring
+ *
+ * Exactly one thread may push and exactly one thread may pop. Head and
+ * tail live on their own cache lines, and each side keeps a cached copy
+ * of the other side's index so it only touches the shared line when the
+ * ring looks full (producer) or empty (consumer).
+ */
+template <typename T>
+class SpscRing {
+private:
+    std::vector<T, AlignedAllocator<T>> slots;
+    size_t mask = 0;
+    
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};  // Next slot to write (producer)
+    size_t cached_tail = 0;                                // Producer's view of tail
+    
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};  // Next slot to read (consumer)
+    size_t cached_head = 0;                                // Consumer's view of head
+    
+public:
+    /**
+     * @param capacity Rounded up to a power of two
+     */
+    explicit SpscRing(size_t capacity = 1 << 16) {
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        slots.resize(n);
+        mask = n - 1;
+    }
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /**
+     * Producer: append one item
+     * @return false if the ring is full
+     */
+    bool try_push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail > mask) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail > mask) return false;
+        }
+        slots[h & mask] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Consumer: remove one item
+     * @return false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == cached_head) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t == cached_head) return false;
+        }
+        item = slots[t & mask];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Consumer: hand up to `max_items` queued items to fn(const T&) and
+     * release them with a single tail update
+     * @return Items consumed
+     */
+    template <typename Fn>
+    size_t consume(Fn&& fn, size_t max_items = SIZE_MAX) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        cached_head = head.load(std::memory_order_acquire);
+        size_t available = cached_head - t;
+        size_t n = (available < max_items) ? available : max_items;
+        for (size_t i = 0; i < n; i++) {
+            fn(slots[(t + i) & mask]);
+        }
+        if (n > 0) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+    
+    /**
+     * Consumer: like consume(), but stops at the first item for which
+     * fn(const T&) returns false (that item stays queued)
+     * @return Items consumed
+     */
+    template <typename Fn>
+    size_t consume_while(Fn&& fn, size_t max_items = SIZE_MAX) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        cached_head = head.load(std::memory_order_acquire);
+        size_t available = cached_head - t;
+        size_t limit = (available < max_items) ? available : max_items;
+        size_t n = 0;
+        while (n < limit && fn(slots[(t + n) & mask])) n++;
+        if (n > 0) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+    
+    /**
+     * Items queued (exact from either side when the other is idle)
+     */
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask + 1; }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include "price.h"
+
+/**
+ * Tradable instrument and its price-model parameters
+ */
+struct SymbolSpec {
+    std::string name;              // Symbol (e.g., "BTC/USD")
+    double base_price = 50000.0;   // Starting mid price
+    double volatility = 0.0002;    // Per-update volatility (fraction of price)
+    double tick_size = 0.01;       // Minimum price increment
+    
+    // Tick size assumed for recorded or external symbols with no known spec
+    // (fine enough for 5-6 decimal FX and crypto quotes)
+    static constexpr double EXTERNAL_TICK_SIZE = 1e-6;
+    
+    SymbolSpec() = default;
+    SymbolSpec(const std::string& name, double base_price, double volatility, double tick_size)
+        : name(name), base_price(base_price), volatility(volatility), tick_size(tick_size) {}
+    
+    // Round a price down / up to the tick grid
+    double floor_to_tick(double price) const { return std::floor(price / tick_size) * tick_size; }
+    double ceil_to_tick(double price) const { return std::ceil(price / tick_size) * tick_size; }
+    
+    // Fixed-point conversions (see price.h)
+    TickScale scale() const { return TickScale(tick_size); }
+    Ticks to_ticks(double price) const { return scale().to_ticks(price); }
+    double to_price(Ticks ticks) const { return static_cast<double>(ticks) * tick_size; }
+    
+    /**
+     * Spec for an externally quoted symbol: the known universe's tick size
+     * if the name is in it, EXTERNAL_TICK_SIZE otherwise
+     */
+    static SymbolSpec external(const std::string& name, const std::vector<SymbolSpec>& known = {}) {
+        for (const auto& spec : known) {
+            if (spec.name == name) return SymbolSpec(name, 0.0, 0.0, spec.tick_size);
+        }
+        return SymbolSpec(name, 0.0, 0.0, EXTERNAL_TICK_SIZE);
+    }
+};
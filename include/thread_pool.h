@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Fixed-size worker pool for data-parallel loops
+ * parallel_for splits [0, count) into contiguous chunks, runs them on the
+ * workers plus the calling thread, and returns when all chunks are done.
+ * Chunk boundaries depend only on `count` and `chunks`, never on timing.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    
+    const std::function<void(size_t, size_t, size_t)>* job = nullptr;
+    size_t job_count = 0;
+    size_t job_chunks = 0;
+    size_t next_chunk = 0;
+    size_t chunks_finished = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+    
+public:
+    /**
+     * @param num_threads Total parallelism including the calling thread
+     */
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency()) {
+        num_threads = std::max<size_t>(1, num_threads);
+        for (size_t i = 1; i < num_threads; i++) {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    size_t size() const { return workers.size() + 1; }
+    
+    /**
+     * Run fn(chunk, begin, end) over `chunks` contiguous slices of [0, count)
+     */
+    void parallel_for(size_t count, size_t chunks,
+                      const std::function<void(size_t, size_t, size_t)>& fn) {
+        chunks = std::max<size_t>(1, std::min(chunks, count));
+        if (count == 0) return;
+        if (workers.empty() || chunks == 1) {
+            for (size_t c = 0; c < chunks; c++) {
+                fn(c, chunk_begin(count, chunks, c), chunk_begin(count, chunks, c + 1));
+            }
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            job_count = count;
+            job_chunks = chunks;
+            next_chunk = 0;
+            chunks_finished = 0;
+            generation++;
+        }
+        work_ready.notify_all();
+        
+        run_chunks();
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        work_done.wait(lock, [this] { return chunks_finished == job_chunks; });
+        job = nullptr;
+    }
+    
+    /**
+     * Run fn(begin, end) with one chunk per thread
+     */
+    void parallel_for(size_t count, const std::function<void(size_t, size_t)>& fn) {
+        parallel_for(count, size(), [&fn](size_t, size_t begin, size_t end) { fn(begin, end); });
+    }
+    
+    static size_t chunk_begin(size_t count, size_t chunks, size_t chunk) {
+        return count * chunk / chunks;
+    }
+    
+private:
+    void worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_ready.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            run_chunks();
+        }
+    }
+    
+    void run_chunks() {
+        for (;;) {
+            size_t chunk;
+            const std::function<void(size_t, size_t, size_t)>* fn;
+            size_t count, chunks;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!job || next_chunk >= job_chunks) return;
+                chunk = next_chunk++;
+                fn = job;
+                count = job_count;
+                chunks = job_chunks;
+            }
+            
+            (*fn)(chunk, chunk_begin(count, chunks, chunk), chunk_begin(count, chunks, chunk + 1));
+            
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++chunks_finished == job_chunks) work_done.notify_all();
+        }
+    }
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "philox.h"
+
+/**
+ * Arrival process of one symbol/venue tick stream
+ */
+enum class ArrivalProcess {
+    POISSON,    // Constant intensity
+    HAWKES      // Self-exciting: every tick raises the intensity, which then decays
+};
+
+/**
+ * Intensity parameters (rates in ticks per simulated second)
+ * Hawkes intensity: lambda(t) = base_rate + sum(alpha * exp(-beta * (t - t_i)))
+ * The process is stationary only when alpha / beta < 1 (mean rate = base_rate / (1 - alpha / beta))
+ */
+struct ArrivalParams {
+    ArrivalProcess process = ArrivalProcess::POISSON;
+    double base_rate = 1.0;  // mu
+    double alpha = 0.0;      // Intensity jump per tick
+    double beta = 1.0;       // Excitation decay rate
+    
+    static ArrivalParams poisson(double rate) {
+        ArrivalParams p;
+        p.process = ArrivalProcess::POISSON;
+        p.base_rate = rate;
+        return p;
+    }
+    
+    static ArrivalParams hawkes(double base_rate, double alpha, double beta) {
+        ArrivalParams p;
+        p.process = ArrivalProcess::HAWKES;
+        p.base_rate = base_rate;
+        p.alpha = alpha;
+        p.beta = beta;
+        return p;
+    }
+    
+    /**
+     * Long-run ticks per second (infinity for an explosive Hawkes process)
+     */
+    double mean_rate() const {
+        if (process == ArrivalProcess::POISSON) return base_rate;
+        double branching = alpha / beta;
+        return (branching < 1.0) ? base_rate / (1.0 - branching) : std::numeric_limits<double>::infinity();
+    }
+    
+    bool operator==(const ArrivalParams& other) const {
+        return process == other.process && base_rate == other.base_rate && alpha == other.alpha && beta == other.beta;
+    }
+    bool operator!=(const ArrivalParams& other) const { return !(*this == other); }
+};
+
+/**
+ * One scheduled tick
+ */
+struct TickEvent {
+    double time;       // Simulated seconds
+    uint32_t symbol;
+    uint32_t venue;
+};
+
+/**
+ * Event-driven tick arrival model
+ *
+ * Every (symbol, venue) stream has its own Poisson or Hawkes process and
+ * exactly one pending event in a time-ordered binary heap. Popping an
+ * event samples that stream's next arrival, so the heap stays at one entry
+ * per stream and advancing costs O(log streams) per tick.
+ *
+ * Hawkes arrivals use Ogata thinning: between ticks the intensity only
+ * decays, so the intensity at the proposal start bounds it until the next
+ * accepted tick. Draws come from Philox addressed by (per-stream draw
+ * counter, symbol, venue), so the event sequence depends only on the seed.
+ */
+class TickArrivalModel {
+private:
+    struct Stream {
+        ArrivalParams params;
+        double excitation = 0.0;   // lambda(last_time) - base_rate
+        double last_time = 0.0;    // Time of the last tick
+        uint64_t draws = 0;        // RNG address for the next draw
+        uint64_t ticks = 0;        // Ticks emitted so far
+    };
+    
+    std::vector<Stream> streams;   // symbol * num_venues + venue
+    std::vector<TickEvent> heap;   // Min-heap on (time, symbol, venue)
+    size_t num_symbols = 0;
+    size_t num_venues = 0;
+    double current_time = 0.0;
+    uint64_t total_ticks = 0;
+    CounterRng rng;
+    
+    static constexpr uint32_t STREAM_ARRIVAL = 2;
+    
+    // Orders the heap as a min-heap; ties broken by key for determinism
+    struct Later {
+        bool operator()(const TickEvent& a, const TickEvent& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            if (a.symbol != b.symbol) return a.symbol > b.symbol;
+            return a.venue > b.venue;
+        }
+    };
+    
+public:
+    explicit TickArrivalModel(uint64_t seed = 0) : rng(seed) {}
+    
+    /**
+     * Give every symbol/venue stream the same process and schedule its first tick
+     */
+    void initialize(size_t symbols, size_t venues, const ArrivalParams& params, double start_time = 0.0) {
+        num_symbols = symbols;
+        num_venues = venues;
+        current_time = start_time;
+        total_ticks = 0;
+        
+        streams.assign(symbols * venues, Stream());
+        for (auto& stream : streams) {
+            stream.params = params;
+            stream.last_time = start_time;
+        }
+        
+        heap.clear();
+        heap.reserve(streams.size());
+        for (size_t key = 0; key < streams.size(); key++) {
+            heap.push_back(TickEvent{ sample_next(key, start_time), key_symbol(key), key_venue(key) });
+        }
+        std::make_heap(heap.begin(), heap.end(), Later());
+    }
+    
+    /**
+     * Change one stream's process
+     * The pending tick is resampled from the current time under the new parameters
+     */
+    void set_params(uint32_t symbol, uint32_t venue, const ArrivalParams& params) {
+        if (symbol >= num_symbols || venue >= num_venues) return;
+        size_t key = make_key(symbol, venue);
+        streams[key].params = params;
+        
+        for (auto& event : heap) {
+            if (event.symbol == symbol && event.venue == venue) {
+                event.time = sample_next(key, current_time);
+                break;
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), Later());
+    }
+    
+    /**
+     * Emit every tick with time <= end_time in time order
+     * @param on_tick Called as on_tick(const TickEvent&) before the stream's next tick is scheduled
+     * @return Number of ticks emitted
+     */
+    template <typename Fn>
+    size_t advance_until(double end_time, Fn&& on_tick) {
+        size_t emitted = 0;
+        while (!heap.empty() && heap.front().time <= end_time) {
+            std::pop_heap(heap.begin(), heap.end(), Later());
+            TickEvent event = heap.back();
+            current_time = event.time;
+            
+            on_tick(event);
+            emitted++;
+            
+            // Register the tick, then sample this stream's next arrival in place
+            size_t key = make_key(event.symbol, event.venue);
+            Stream& stream = streams[key];
+            if (stream.params.process == ArrivalProcess::HAWKES) {
+                stream.excitation = decayed_excitation(stream, event.time) + stream.params.alpha;
+            }
+            stream.last_time = event.time;
+            stream.ticks++;
+            
+            heap.back().time = sample_next(key, event.time);
+            std::push_heap(heap.begin(), heap.end(), Later());
+        }
+        
+        current_time = std::max(current_time, end_time);
+        total_ticks += emitted;
+        return emitted;
+    }
+    
+    /**
+     * Current intensity of a stream (ticks per second)
+     */
+    double intensity(uint32_t symbol, uint32_t venue) const {
+        if (symbol >= num_symbols || venue >= num_venues) return 0.0;
+        const Stream& stream = streams[make_key(symbol, venue)];
+        if (stream.params.process == ArrivalProcess::POISSON) return stream.params.base_rate;
+        return stream.params.base_rate + decayed_excitation(stream, current_time);
+    }
+    
+    double next_event_time() const {
+        return heap.empty() ? std::numeric_limits<double>::infinity() : heap.front().time;
+    }
+    
+    uint64_t stream_ticks(uint32_t symbol, uint32_t venue) const {
+        return streams[make_key(symbol, venue)].ticks;
+    }
+    
+    double now() const { return current_time; }
+    uint64_t get_total_ticks() const { return total_ticks; }
+    size_t num_streams() const { return streams.size(); }
+    
+private:
+    size_t make_key(uint32_t symbol, uint32_t venue) const {
+        return static_cast<size_t>(symbol) * num_venues + venue;
+    }
+    
+    uint32_t key_symbol(size_t key) const { return static_cast<uint32_t>(key / num_venues); }
+    uint32_t key_venue(size_t key) const { return static_cast<uint32_t>(key % num_venues); }
+    
+    double decayed_excitation(const Stream& stream, double t) const {
+        return stream.excitation * std::exp(-stream.params.beta * (t - stream.last_time));
+    }
+    
+    /**
+     * Sample the next arrival of a stream after time `from`
+     * @return infinity if the stream never ticks (zero intensity)
+     */
+    double sample_next(size_t key, double from) {
+        Stream& stream = streams[key];
+        const ArrivalParams& p = stream.params;
+        uint32_t symbol = key_symbol(key);
+        uint32_t venue = key_venue(key);
+        
+        if (p.process == ArrivalProcess::POISSON) {
+            if (p.base_rate <= 0.0) return std::numeric_limits<double>::infinity();
+            auto r = rng.draw(stream.draws++, symbol, venue, STREAM_ARRIVAL);
+            return from - std::log(Philox4x32::to_uniform(r.v[0])) / p.base_rate;
+        }
+        
+        // Ogata thinning: propose from the current (upper-bound) intensity,
+        // accept with probability lambda(t) / bound
+        double t = from;
+        for (;;) {
+            double bound = p.base_rate + decayed_excitation(stream, t);
+            if (bound <= 0.0) return std::numeric_limits<double>::infinity();
+            
+            auto r = rng.draw(stream.draws++, symbol, venue, STREAM_ARRIVAL);
+            
+            // Each Philox block carries two proposals
+            for (int k = 0; k < 4; k += 2) {
+                t -= std::log(Philox4x32::to_uniform(r.v[k])) / bound;
+                double lambda = p.base_rate + decayed_excitation(stream, t);
+                if (Philox4x32::to_uniform(r.v[k + 1]) * bound <= lambda) return t;
+                bound = lambda;
+            }
+        }
+    }
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "binary_io.h"
+#include "mapped_file.h"
+
+/**
+ * One recorded top-of-book update (32 bytes, fixed size so a mapped file
+ * is directly an array of records)
+ */
+struct TickRecord {
+    uint64_t timestamp_ns;   // Nanoseconds since epoch
+    uint16_t symbol;         // Index into the file's symbol table
+    uint16_t venue;          // Index into the file's venue table
+    float volume;
+    double bid;
+    double ask;
+};
+static_assert(sizeof(TickRecord) == 32, "TickRecord must stay 32 bytes");
+
+/**
+ * On-disk header of a tick file
+ * Layout: header | records | symbol names | venue names
+ * Records are sorted by timestamp. The name tables trail the records so
+ * a writer can stream records before it has seen every name. Only the
+ * header and name tables are checksummed; the record array is validated
+ * by size so multi-GB files open without touching every page.
+ */
+struct TickFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t num_symbols;
+    uint32_t num_venues;
+    uint64_t num_records;
+    uint64_t first_timestamp_ns;
+    uint64_t last_timestamp_ns;
+    uint64_t records_offset;       // Byte offset of the record array (64-aligned)
+    uint64_t tables_offset;        // Byte offset of the name tables (end of records)
+    uint64_t tables_checksum;      // checksum64 of the name tables
+};
+
+constexpr uint64_t TICK_FILE_MAGIC = 0x314B434954534CULL; // "LSTICK1"
+constexpr uint32_t TICK_FILE_VERSION = 2;   // 2: name tables trail the records (tables_offset)
+
+/**
+ * Streaming tick file writer
+ * Records go straight to disk so recordings are not bounded by RAM; the
+ * name tables and header are written by finish()
+ */
+class TickFileWriter {
+private:
+    std::ofstream file;
+    TickFileHeader header{};
+    std::vector<std::string> symbol_names;
+    std::vector<std::string> venue_names;
+    uint64_t last_timestamp = 0;
+    bool sorted = true;
+    
+public:
+    /**
+     * Create a file; set_tables() must be called before finish()
+     */
+    bool open(const std::string& path) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        
+        header = TickFileHeader{};
+        header.magic = TICK_FILE_MAGIC;
+        header.version = TICK_FILE_VERSION;
+        header.header_size = sizeof(TickFileHeader);
+        header.records_offset = (sizeof(TickFileHeader) + 63) / 64 * 64;
+        symbol_names.clear();
+        venue_names.clear();
+        last_timestamp = 0;
+        sorted = true;
+        
+        // Placeholder header + padding; back-patched by finish()
+        std::vector<char> prefix(header.records_offset, 0);
+        file.write(prefix.data(), prefix.size());
+        return static_cast<bool>(file);
+    }
+    
+    /**
+     * Create a file whose symbol/venue names are known up front
+     */
+    bool open(const std::string& path, const std::vector<std::string>& symbols,
+              const std::vector<std::string>& venues) {
+        return open(path) && set_tables(symbols, venues);
+    }
+    
+    /**
+     * Name tables that record symbol/venue indices refer to
+     */
+    bool set_tables(const std::vector<std::string>& symbols, const std::vector<std::string>& venues) {
+        if (symbols.size() > UINT16_MAX + 1u || venues.size() > UINT16_MAX + 1u) return false;
+        symbol_names = symbols;
+        venue_names = venues;
+        return true;
+    }
+    
+    /**
+     * Append one record (timestamps must be non-decreasing)
+     */
+    void write(const TickRecord& record) {
+        write(&record, 1);
+    }
+    
+    /**
+     * Append a block of records with a single write
+     */
+    void write(const TickRecord* records, size_t count) {
+        if (count == 0) return;
+        if (header.num_records == 0) header.first_timestamp_ns = records[0].timestamp_ns;
+        for (size_t i = 0; i < count; i++) {
+            if (records[i].timestamp_ns < last_timestamp) sorted = false;
+            last_timestamp = records[i].timestamp_ns;
+        }
+        header.num_records += count;
+        file.write(reinterpret_cast<const char*>(records), count * sizeof(TickRecord));
+    }
+    
+    /**
+     * Append the name tables, write the final header and close
+     * @return false on an I/O error or out-of-order timestamps
+     */
+    bool finish() {
+        if (!file.is_open()) return false;
+        
+        BinaryWriter tables;
+        for (const auto& name : symbol_names) tables.write_string(name);
+        for (const auto& name : venue_names) tables.write_string(name);
+        
+        header.num_symbols = static_cast<uint32_t>(symbol_names.size());
+        header.num_venues = static_cast<uint32_t>(venue_names.size());
+        header.last_timestamp_ns = last_timestamp;
+        header.tables_offset = header.records_offset + header.num_records * sizeof(TickRecord);
+        header.tables_checksum = checksum64(tables.data(), tables.size());
+        
+        file.write(tables.data(), tables.size());
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        bool ok = static_cast<bool>(file) && sorted;
+        file.close();
+        return ok;
+    }
+    
+    uint64_t records_written() const { return header.num_records; }
+    bool is_sorted() const { return sorted; }
+    uint64_t last_timestamp_ns() const { return last_timestamp; }
+};
+
+/**
+ * Read-only view of a tick file mapped into memory
+ */
+class TickFile {
+private:
+    MappedFile file;
+    TickFileHeader header{};
+    const TickRecord* records = nullptr;
+    std::vector<std::string> symbol_names;
+    std::vector<std::string> venue_names;
+    
+public:
+    /**
+     * Map and validate a tick file
+     * @return false on a missing, truncated, corrupt or version-mismatched file
+     */
+    bool open(const std::string& path) {
+        close();
+        if (!file.open(path)) return false;
+        
+        BinaryReader reader(file.data(), file.size());
+        TickFileHeader h;
+        if (!reader.read(h) ||
+            h.magic != TICK_FILE_MAGIC ||
+            h.version != TICK_FILE_VERSION ||
+            h.header_size != sizeof(TickFileHeader) ||
+            h.num_symbols > UINT16_MAX + 1u || h.num_venues > UINT16_MAX + 1u ||
+            h.records_offset % 64 != 0 ||
+            h.records_offset < sizeof(TickFileHeader) ||
+            h.tables_offset > file.size() ||
+            h.tables_offset < h.records_offset ||
+            (h.tables_offset - h.records_offset) % sizeof(TickRecord) != 0 ||
+            h.num_records != (h.tables_offset - h.records_offset) / sizeof(TickRecord)) {
+            close();
+            return false;
+        }
+        
+        BinaryReader tables(file.data() + h.tables_offset, file.size() - h.tables_offset);
+        std::vector<std::string> symbols(h.num_symbols), venues(h.num_venues);
+        for (auto& name : symbols) tables.read_string(name);
+        for (auto& name : venues) tables.read_string(name);
+        if (!tables.ok() || tables.remaining() != 0 ||
+            checksum64(file.data() + h.tables_offset, tables.position()) != h.tables_checksum) {
+            close();
+            return false;
+        }
+        
+        header = h;
+        symbol_names = std::move(symbols);
+        venue_names = std::move(venues);
+        records = reinterpret_cast<const TickRecord*>(file.data() + header.records_offset);
+        file.advise_sequential();
+        return true;
+    }
+    
+    void close() {
+        file.close();
+        header = TickFileHeader{};
+        records = nullptr;
+        symbol_names.clear();
+        venue_names.clear();
+    }
+    
+    bool is_open() const { return records != nullptr; }
+    const TickRecord* data() const { return records; }
+    size_t size() const { return static_cast<size_t>(header.num_records); }
+    const TickRecord& operator[](size_t i) const { return records[i]; }
+    
+    const std::vector<std::string>& symbols() const { return symbol_names; }
+    const std::vector<std::string>& venues() const { return venue_names; }
+    uint64_t first_timestamp_ns() const { return header.first_timestamp_ns; }
+    uint64_t last_timestamp_ns() const { return header.last_timestamp_ns; }
+};
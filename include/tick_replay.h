@@ -0,0 +1,206 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "tick_file.h"
+#include "price_feed.h"
+
+/**
+ * How fast recorded time advances relative to wall time
+ */
+enum class ReplayPace {
+    REAL_TIME,             // 1 recorded second per wall second
+    ACCELERATED,           // `speed` recorded seconds per wall second
+    AS_FAST_AS_POSSIBLE    // No pacing; each pump applies a fixed batch
+};
+
+/**
+ * Replays a recorded tick file into a PriceFeed
+ *
+ * The file is mmap'd and walked front to back, so memory use is the page
+ * cache's business rather than ours and multi-GB recordings stream without
+ * a load step. Records are mapped from the file's symbol/venue tables to
+ * feed handles once in bind(); ticks for symbols or venues the feed does
+ * not quote are counted and skipped.
+ */
+class TickReplay {
+private:
+    TickFile file;
+    std::vector<int> symbol_handles;   // File symbol index -> feed symbol handle (-1 = skip)
+    std::vector<int> venue_handles;    // File venue index -> feed venue handle (-1 = skip)
+    size_t cursor = 0;                 // Next record to apply
+    
+    ReplayPace pace = ReplayPace::REAL_TIME;
+    double speed = 1.0;
+    bool running = false;
+    std::chrono::steady_clock::time_point wall_anchor;
+    uint64_t replay_anchor_ns = 0;     // Recorded time at wall_anchor
+    
+    uint64_t applied = 0;
+    uint64_t skipped = 0;
+    
+public:
+    // Records applied per pump() call in AS_FAST_AS_POSSIBLE mode
+    static constexpr size_t FAST_BATCH = 1 << 16;
+    
+    /**
+     * Map a tick file and rewind to its first record
+     */
+    bool open(const std::string& path) {
+        if (!file.open(path)) return false;
+        symbol_handles.assign(file.symbols().size(), -1);
+        venue_handles.assign(file.venues().size(), -1);
+        rewind();
+        return true;
+    }
+    
+    /**
+     * Resolve the file's symbol and venue names against a feed
+     * @return Number of file symbols the feed quotes
+     */
+    size_t bind(const PriceFeed& feed) {
+        size_t matched = 0;
+        for (size_t i = 0; i < file.symbols().size(); i++) {
+            symbol_handles[i] = feed.get_symbol_handle(file.symbols()[i]);
+            if (symbol_handles[i] >= 0) matched++;
+        }
+        for (size_t i = 0; i < file.venues().size(); i++) {
+            venue_handles[i] = feed.get_venue_handle(file.venues()[i]);
+        }
+        return matched;
+    }
+    
+    /**
+     * Map every file index to itself, for sinks that share the file's
+     * symbol/venue tables (e.g. a ShmQuotePublisher created from them)
+     */
+    void bind_identity() {
+        for (size_t i = 0; i < symbol_handles.size(); i++) symbol_handles[i] = static_cast<int>(i);
+        for (size_t i = 0; i < venue_handles.size(); i++) venue_handles[i] = static_cast<int>(i);
+    }
+    
+    /**
+     * Select the pacing mode
+     * @param multiple Recorded seconds per wall second (ACCELERATED only)
+     */
+    void set_pace(ReplayPace new_pace, double multiple = 1.0) {
+        uint64_t now_ns = current_time_ns();
+        pace = new_pace;
+        speed = (pace == ReplayPace::ACCELERATED) ? std::max(multiple, 1e-6) : 1.0;
+        anchor(now_ns);
+    }
+    
+    /**
+     * Start (or resume) pacing from the current position
+     */
+    void start() {
+        running = true;
+        anchor(current_time_ns());
+    }
+    
+    void pause() { running = false; }
+    
+    /**
+     * Apply every record that is due
+     * Paced modes apply records up to the recorded time reached by the
+     * wall clock; AS_FAST_AS_POSSIBLE applies the next `max_records`.
+     * The sink is a PriceFeed or anything else with PriceFeed's
+     * apply_quote() signature (e.g. a FeedHandler).
+     * @return Records consumed (applied or skipped)
+     */
+    template <typename Sink>
+    size_t pump(Sink& sink, size_t max_records = FAST_BATCH) {
+        if (!running || finished()) return 0;
+        if (pace == ReplayPace::AS_FAST_AS_POSSIBLE) {
+            return apply_records(sink, std::min(file.size(), cursor + max_records));
+        }
+        
+        double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_anchor).count();
+        uint64_t target_ns = replay_anchor_ns + static_cast<uint64_t>(elapsed_s * speed * 1e9);
+        return replay_until(sink, target_ns, max_records);
+    }
+    
+    /**
+     * Apply records with timestamp <= time_ns regardless of pacing
+     * (for headless loops that step recorded time explicitly)
+     */
+    template <typename Sink>
+    size_t replay_until(Sink& sink, uint64_t time_ns, size_t max_records = SIZE_MAX) {
+        size_t limit = (max_records >= file.size() - cursor) ? file.size() : cursor + max_records;
+        const TickRecord* records = file.data();
+        size_t end = cursor;
+        while (end < limit && records[end].timestamp_ns <= time_ns) end++;
+        return apply_records(sink, end);
+    }
+    
+    /**
+     * Jump to the first record at or after time_ns
+     */
+    void seek(uint64_t time_ns) {
+        const TickRecord* begin = file.data();
+        const TickRecord* end = begin + file.size();
+        const TickRecord* it = std::lower_bound(begin, end, time_ns,
+            [](const TickRecord& r, uint64_t t) { return r.timestamp_ns < t; });
+        cursor = static_cast<size_t>(it - begin);
+        anchor(current_time_ns());
+    }
+    
+    void rewind() {
+        cursor = 0;
+        applied = 0;
+        skipped = 0;
+        anchor(file.first_timestamp_ns());
+    }
+    
+    bool is_open() const { return file.is_open(); }
+    bool is_running() const { return running; }
+    bool finished() const { return cursor >= file.size(); }
+    
+    /**
+     * Recorded time of the replay position (ns since epoch)
+     */
+    uint64_t current_time_ns() const {
+        if (file.size() == 0) return 0;
+        if (cursor == 0) return file.first_timestamp_ns();
+        return file[cursor - 1].timestamp_ns;
+    }
+    
+    size_t position() const { return cursor; }
+    size_t size() const { return file.size(); }
+    uint64_t records_applied() const { return applied; }
+    uint64_t records_skipped() const { return skipped; }
+    ReplayPace get_pace() const { return pace; }
+    double get_speed() const { return speed; }
+    const TickFile& get_file() const { return file; }
+    
+private:
+    void anchor(uint64_t replay_ns) {
+        wall_anchor = std::chrono::steady_clock::now();
+        replay_anchor_ns = replay_ns;
+    }
+    
+    /**
+     * Apply records [cursor, end) to the sink
+     */
+    template <typename Sink>
+    size_t apply_records(Sink& sink, size_t end) {
+        const TickRecord* records = file.data();
+        size_t begin = cursor;
+        for (size_t i = begin; i < end; i++) {
+            const TickRecord& r = records[i];
+            int symbol = (r.symbol < symbol_handles.size()) ? symbol_handles[r.symbol] : -1;
+            int venue = (r.venue < venue_handles.size()) ? venue_handles[r.venue] : -1;
+            if (symbol < 0 || venue < 0) {
+                skipped++;
+                continue;
+            }
+            sink.apply_quote(symbol, venue, r.bid, r.ask, r.volume, r.timestamp_ns);
+            applied++;
+        }
+        cursor = end;
+        return end - begin;
+    }
+};
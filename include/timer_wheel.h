@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Hierarchical timer wheel
+ *
+ * Time is an integer step count. Level 0 has one slot per step for the
+ * next 64 steps; each higher level has slots 64x wider. A timer is filed in
+ * the lowest level whose span covers its delay and cascades one level down
+ * whenever the level below wraps, so scheduling is O(1) and each timer is
+ * moved at most LEVELS - 1 times before it fires. Delays past the top
+ * level's span are parked in its farthest slot and re-filed on arrival.
+ */
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+private:
+    struct Timer {
+        uint64_t due;
+        T value;
+    };
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    std::vector<Timer> firing;   // Scratch for the slot being expired
+    uint64_t current = 0;        // Last step processed
+    size_t pending = 0;
+
+public:
+    /**
+     * Drop every timer and restart the clock at `step`
+     */
+    void reset(uint64_t step = 0) {
+        for (auto& level : slots) {
+            for (auto& slot : level) slot.clear();
+        }
+        current = step;
+        pending = 0;
+    }
+
+    /**
+     * File a timer for step `due` (timers already due fire on the next advance)
+     */
+    void schedule(uint64_t due, const T& value) {
+        if (due <= current) due = current + 1;
+        place(Timer{ due, value });
+        pending++;
+    }
+
+    /**
+     * Fire every timer due at or before step `now`, in step order
+     * fn(value, due) may schedule new timers
+     * @return Timers fired
+     */
+    template <typename Fn>
+    size_t advance(uint64_t now, Fn&& fn) {
+        size_t fired = 0;
+        while (current < now) {
+            if (pending == 0) {
+                current = now;
+                break;
+            }
+            current++;
+
+            // Pull the next span of each wrapping level down a level
+            for (int level = 1; level < LEVELS; level++) {
+                if ((current & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+                auto& slot = slots[level][(current >> (SLOT_BITS * level)) & SLOT_MASK];
+                firing.swap(slot);
+                for (const Timer& t : firing) place(t);
+                firing.clear();
+            }
+
+            auto& slot = slots[0][current & SLOT_MASK];
+            if (slot.empty()) continue;
+            firing.swap(slot);
+            for (const Timer& t : firing) {
+                if (t.due > current) {
+                    place(t);       // Parked past the wheel's horizon
+                    continue;
+                }
+                pending--;
+                fired++;
+                fn(t.value, t.due);
+            }
+            firing.clear();
+        }
+        return fired;
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+    bool empty() const { return pending == 0; }
+    
+    /**
+     * Visit every pending timer as fn(value, due), in no particular order
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& level : slots) {
+            for (const auto& slot : level) {
+                for (const Timer& t : slot) fn(t.value, t.due);
+            }
+        }
+    }
+
+    /**
+     * Steps covered by the wheel before timers are parked
+     */
+    static constexpr uint64_t horizon() { return uint64_t(1) << (SLOT_BITS * LEVELS); }
+
+private:
+    void place(const Timer& t) {
+        uint64_t delay = t.due - current;
+        for (int level = 0; level < LEVELS; level++) {
+            if (delay < (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+                slots[level][(t.due >> (SLOT_BITS * level)) & SLOT_MASK].push_back(t);
+                return;
+            }
+        }
+        // Farthest top-level slot; re-filed when it cascades
+        uint64_t top = current + horizon() - 1;
+        slots[LEVELS - 1][(top >> (SLOT_BITS * (LEVELS - 1))) & SLOT_MASK].push_back(t);
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#define LAS_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define LAS_HAS_TSC 1
+#else
+#define LAS_HAS_TSC 0
+#endif
+
+/**
+ * Nanosecond clock for quote and opportunity timestamps
+ *
+ * Reads the CPU's invariant time-stamp counter (one rdtsc plus a
+ * multiply-add, ~10 ns on bare metal) scaled by a rate calibrated once
+ * against steady_clock. Readings are anchored to system_clock at
+ * calibration, so they are nanoseconds since the Unix epoch, comparable
+ * with recorded tick times, yet never jump when the wall clock is
+ * adjusted. Without an invariant TSC (or off x86) it falls back to
+ * steady_clock with the same epoch anchor.
+ */
+class TscClock {
+private:
+    struct Calibration {
+        bool use_tsc = false;
+        uint64_t tsc_base = 0;
+        double ns_per_cycle = 0.0;
+        uint64_t epoch_base_ns = 0;   // now_ns() at tsc_base
+        int64_t steady_to_epoch_ns = 0;
+    };
+    
+public:
+    /**
+     * Nanoseconds since the Unix epoch (monotonic)
+     */
+    static uint64_t now_ns() {
+        const Calibration& c = calibration();
+#if LAS_HAS_TSC
+        if (c.use_tsc) {
+            return c.epoch_base_ns + static_cast<uint64_t>(static_cast<double>(__rdtsc() - c.tsc_base) * c.ns_per_cycle);
+        }
+#endif
+        return static_cast<uint64_t>(steady_ns() + c.steady_to_epoch_ns);
+    }
+    
+    /**
+     * Milliseconds since the Unix epoch, for display
+     */
+    static uint64_t now_ms() { return now_ns() / 1000000; }
+    
+    static bool uses_tsc() { return calibration().use_tsc; }
+    
+    /**
+     * Measured TSC frequency (0 when falling back to steady_clock)
+     */
+    static double tsc_ghz() {
+        const Calibration& c = calibration();
+        return c.use_tsc ? 1.0 / c.ns_per_cycle : 0.0;
+    }
+    
+    /**
+     * Run the calibration now instead of on the first read (~10 ms)
+     */
+    static void calibrate() { calibration(); }
+    
+private:
+    static int64_t steady_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    static int64_t system_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    /**
+     * CPUID leaf 0x80000007, EDX bit 8: TSC ticks at a constant rate in
+     * every P/C-state and is synchronized across cores
+     */
+    static bool has_invariant_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) || eax < 0x80000007u) return false;
+        __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+        return (edx & (1u << 8)) != 0;
+#elif defined(_M_X64) || defined(_M_IX86)
+        int regs[4];
+        __cpuid(regs, 0x80000000);
+        if (static_cast<unsigned int>(regs[0]) < 0x80000007u) return false;
+        __cpuid(regs, 0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+    
+    static const Calibration& calibration() {
+        static const Calibration c = measure();
+        return c;
+    }
+    
+    static Calibration measure() {
+        Calibration c;
+        c.steady_to_epoch_ns = system_ns() - steady_ns();
+#if LAS_HAS_TSC
+        if (!has_invariant_tsc()) return c;
+        
+        // Count cycles over ~10 ms of steady_clock; each end is a counter read
+        // bracketed by two clock reads, so a preempted sample cannot skew it
+        int64_t steady_start = 0;
+        uint64_t tsc_start = paired_read(steady_start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int64_t steady_end = 0;
+        uint64_t tsc_end = paired_read(steady_end);
+        if (tsc_end <= tsc_start || steady_end <= steady_start) return c;
+        
+        c.use_tsc = true;
+        c.ns_per_cycle = static_cast<double>(steady_end - steady_start) / static_cast<double>(tsc_end - tsc_start);
+        c.tsc_base = tsc_end;
+        c.epoch_base_ns = static_cast<uint64_t>(steady_end + c.steady_to_epoch_ns);
+#endif
+        return c;
+    }
+
+#if LAS_HAS_TSC
+    /**
+     * TSC read with the steady_clock time it corresponds to (midpoint of
+     * the tightest of a few bracketing clock reads)
+     */
+    static uint64_t paired_read(int64_t& steady) {
+        uint64_t best_tsc = 0;
+        int64_t best_width = std::numeric_limits<int64_t>::max();
+        for (int attempt = 0; attempt < 8; attempt++) {
+            int64_t before = steady_ns();
+            uint64_t tsc = __rdtsc();
+            int64_t after = steady_ns();
+            if (after - before < best_width) {
+                best_width = after - before;
+                best_tsc = tsc;
+                steady = before + (after - before) / 2;
+            }
+        }
+        return best_tsc;
+    }
+#endif
+};
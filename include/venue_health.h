@@ -0,0 +1,232 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "bit_ops.h"
+
+/**
+ * Outcome of checking one sequence number against its venue's stream
+ */
+enum class SequenceCheck {
+    IN_ORDER,    // Next expected (or first seen, or unsequenced)
+    GAP,         // Newer than expected: updates in between were lost
+    RESET,       // Sequence 1 again: the venue restarted its stream
+    DUPLICATE    // Older than expected: replayed or reordered, ignore it
+};
+
+/**
+ * Per-venue sequence number checker
+ *
+ * Sequence numbers are per venue, start at 1 and wrap from 2^32 - 1 back
+ * to 1 (compared as a signed difference). 0 marks an unsequenced update
+ * and is always accepted.
+ */
+class SequenceTracker {
+private:
+    std::vector<uint32_t> expected;   // Next sequence per venue (0 = none seen yet)
+
+public:
+    void resize(size_t venues) { expected.assign(venues, 0); }
+    size_t venues() const { return expected.size(); }
+
+    /**
+     * Check `sequence` from `venue` and advance past it unless it is a duplicate
+     * @param missed Receives the number of sequences skipped (GAP only)
+     */
+    SequenceCheck check(size_t venue, uint32_t sequence, uint32_t* missed = nullptr) {
+        if (sequence == 0 || venue >= expected.size()) return SequenceCheck::IN_ORDER;
+        uint32_t& next = expected[venue];
+        if (next == 0 || sequence == next) {
+            advance(next, sequence);
+            return SequenceCheck::IN_ORDER;
+        }
+        if (sequence == 1) {
+            next = 2;
+            return SequenceCheck::RESET;
+        }
+        int32_t ahead = static_cast<int32_t>(sequence - next);
+        if (ahead < 0) return SequenceCheck::DUPLICATE;
+        if (missed) *missed = static_cast<uint32_t>(ahead);
+        advance(next, sequence);
+        return SequenceCheck::GAP;
+    }
+
+private:
+    static void advance(uint32_t& next, uint32_t sequence) {
+        next = sequence + 1;
+        if (next == 0) next = 1;
+    }
+};
+
+/**
+ * Liveness of each venue's quote stream, as a bitmask the scanner can apply
+ *
+ * Write paths mark a venue seen (one bit OR) and report sequence gaps;
+ * refresh() runs once per frame and turns those bits into times. A venue is
+ * stale when nothing arrived for `stale_after_ns`, and gapped for
+ * `gap_hold_ns` after its last gap; either one sets its bit in mask().
+ * Marking is bit-only so the per-quote cost stays at a couple of
+ * instructions; staleness has the resolution of the refresh interval.
+ */
+class VenueHealth {
+private:
+    SequenceTracker sequences;
+    size_t num_venues = 0;
+
+    // Since the last refresh
+    std::vector<uint64_t> seen_bits;
+    std::vector<uint64_t> gap_bits;
+
+    // As of the last refresh
+    std::vector<uint64_t> last_update_ns;
+    std::vector<uint64_t> last_gap_ns;     // 0 = never gapped
+    std::vector<uint64_t> stale_bits;
+    std::vector<uint64_t> gapped_bits;
+    std::vector<uint64_t> masked_bits;     // stale | gapped
+    size_t masked_count = 0;
+
+    uint64_t stale_after_ns = 0;           // 0 = never stale
+    uint64_t gap_hold_ns = 1000000000;
+
+    uint64_t gaps_total = 0;
+    uint64_t missed_total = 0;
+    uint64_t duplicates_total = 0;
+    uint64_t resets_total = 0;
+
+public:
+    /**
+     * Track `venues` venues, all live and unsequenced
+     */
+    void resize(size_t venues) {
+        num_venues = venues;
+        size_t words = (venues + 63) / 64;
+        sequences.resize(venues);
+        seen_bits.assign(words, 0);
+        gap_bits.assign(words, 0);
+        last_update_ns.assign(venues, 0);
+        last_gap_ns.assign(venues, 0);
+        stale_bits.assign(words, 0);
+        gapped_bits.assign(words, 0);
+        masked_bits.assign(words, 0);
+        masked_count = 0;
+        gaps_total = missed_total = duplicates_total = resets_total = 0;
+    }
+
+    size_t venues() const { return num_venues; }
+
+    /**
+     * Staleness threshold (0 disables stale masking)
+     */
+    void set_stale_after_ns(uint64_t ns) { stale_after_ns = ns; }
+    uint64_t get_stale_after_ns() const { return stale_after_ns; }
+
+    /**
+     * How long a venue stays masked after a sequence gap
+     */
+    void set_gap_hold_ns(uint64_t ns) { gap_hold_ns = ns; }
+    uint64_t get_gap_hold_ns() const { return gap_hold_ns; }
+
+    /**
+     * Check a sequenced update and mark the venue seen
+     * @return false for a duplicate, which should not be applied
+     */
+    bool accept(size_t venue, uint32_t sequence) {
+        if (venue >= num_venues) return true;
+        uint32_t missed = 0;
+        switch (sequences.check(venue, sequence, &missed)) {
+            case SequenceCheck::DUPLICATE:
+                duplicates_total++;
+                return false;
+            case SequenceCheck::GAP:
+                report_gap(venue, missed);
+                break;
+            case SequenceCheck::RESET:
+                resets_total++;
+                break;
+            case SequenceCheck::IN_ORDER:
+                break;
+        }
+        touch(venue);
+        return true;
+    }
+
+    /**
+     * Mark a venue seen (any update proves the stream is alive)
+     */
+    void touch(size_t venue) {
+        if (venue < num_venues) seen_bits[venue / 64] |= 1ULL << (venue & 63);
+    }
+
+    void touch_all() {
+        std::fill(seen_bits.begin(), seen_bits.end(), ~0ULL);
+    }
+
+    /**
+     * Record a gap detected upstream (e.g. by a FeedHandler's ingress thread)
+     */
+    void report_gap(size_t venue, uint64_t missed) {
+        if (venue >= num_venues) return;
+        gap_bits[venue / 64] |= 1ULL << (venue & 63);
+        gaps_total++;
+        missed_total += missed;
+    }
+
+    /**
+     * Fold the bits marked since the last call into times and rebuild the mask
+     * fn(venue) is called for each venue whose mask bit flipped
+     * @return Venues whose mask bit flipped
+     */
+    template <typename Fn>
+    size_t refresh(uint64_t now_ns, Fn&& fn) {
+        size_t flipped = 0;
+        masked_count = 0;
+        for (size_t w = 0; w < masked_bits.size(); w++) {
+            uint64_t stale = 0;
+            uint64_t gapped = 0;
+            size_t end = std::min(num_venues, (w + 1) * 64);
+            for (size_t v = w * 64; v < end; v++) {
+                uint64_t bit = 1ULL << (v & 63);
+                if ((seen_bits[w] & bit) || last_update_ns[v] == 0) last_update_ns[v] = now_ns;
+                if (gap_bits[w] & bit) last_gap_ns[v] = now_ns;
+                if (stale_after_ns && now_ns - last_update_ns[v] > stale_after_ns) stale |= bit;
+                if (last_gap_ns[v] && now_ns - last_gap_ns[v] < gap_hold_ns) gapped |= bit;
+            }
+            seen_bits[w] = 0;
+            gap_bits[w] = 0;
+            stale_bits[w] = stale;
+            gapped_bits[w] = gapped;
+
+            uint64_t changed = masked_bits[w] ^ (stale | gapped);
+            masked_bits[w] = stale | gapped;
+            masked_count += popcount(masked_bits[w]);
+            for (; changed; changed &= changed - 1, flipped++) fn(w * 64 + count_trailing_zeros(changed));
+        }
+        return flipped;
+    }
+
+    size_t refresh(uint64_t now_ns) { return refresh(now_ns, [](size_t) {}); }
+
+    /**
+     * Masked venues, one bit per venue (words() words)
+     */
+    const uint64_t* mask() const { return masked_bits.data(); }
+    size_t words() const { return masked_bits.size(); }
+
+    bool is_masked(size_t venue) const { return test(masked_bits, venue); }
+    bool is_stale(size_t venue) const { return test(stale_bits, venue); }
+    bool is_gapped(size_t venue) const { return test(gapped_bits, venue); }
+    size_t num_masked() const { return masked_count; }
+
+    uint64_t get_last_update_ns(size_t venue) const { return last_update_ns[venue]; }
+    uint64_t total_gaps() const { return gaps_total; }
+    uint64_t total_missed() const { return missed_total; }
+    uint64_t total_duplicates() const { return duplicates_total; }
+    uint64_t total_resets() const { return resets_total; }
+
+private:
+    bool test(const std::vector<uint64_t>& bits, size_t venue) const {
+        return venue < num_venues && ((bits[venue / 64] >> (venue & 63)) & 1);
+    }
+};
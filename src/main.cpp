@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 // CRITICAL: Include GLAD before any OpenGL headers (GLFW, ImGui OpenGL backend)
 #include <glad/glad.h>
@@ -8,39 +9,71 @@
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
-#include <nlohmann/json.hpp>
 
 #include "exchange.h"
 #include "latency_calculator.h"
 #include "network_graph.h"
 #include "price_feed.h"
+#include "tick_arrival_model.h"
+#include "tick_replay.h"
+#include "feed_handler.h"
+#include "shm_quote_ring.h"
 #include "arbitrage_scanner.h"
 #include "globe_renderer.h"
 #include "colocation_optimizer.h"
 #include "historical_tracker.h"
-
-using json = nlohmann::json;
+#include "dislocation_engine.h"
+#include "feed_checkpoint.h"
+#include "data_loader.h"
+#include "tsc_clock.h"
 
 // Global state
 NetworkGraph g_network;
 PriceFeed g_price_feed;
+TickArrivalModel g_tick_model;
+TickReplay g_replay;  // Drives the feed instead of the simulator when running
+bool g_replay_active = false;
+ShmQuoteConsumer g_shm_feed;  // Quotes from a local feed_publisher process (--shm)
+bool g_shm_active = false;
+FeedHandler g_feed_handler;                          // Quote ingestion thread (drained before scans)
+std::shared_ptr<SimulatedFeedSource> g_feed_source;  // Simulated market run by the handler thread
+DislocationEngine g_dislocations;                    // Transient injected price dislocations
+const char* const CHECKPOINT_PATH = "../data/feed_checkpoint.bin";  // Save/Load Checkpoint buttons
 ArbitrageScanner* g_scanner = nullptr;
 GlobeRenderer* g_globe_renderer = nullptr;
 ColocationOptimizer* g_colocation_optimizer = nullptr;
 HistoricalTracker* g_historical_tracker = nullptr;
+ChangeSet g_scan_changes;                            // Quotes changed since the scanner's last incremental scan
 
 std::string g_selected_exchange_1;
 std::string g_selected_exchange_2;
+int g_selected_symbol = 0;
+std::string g_observer_exchange;  // Empty = scan live prices
 TransmissionMedium g_transmission_medium = TransmissionMedium::FIBER_OPTIC;
 
 // Arbitrage settings
-float g_volatility = 0.02f;
+float g_volatility = 0.0002f;
+bool g_volatility_overridden = false;
 float g_min_profit_bps = 5.0f;
 float g_trading_fee = 0.1f;
 float g_opportunity_window = 200.0f;
+float g_stale_after_ms = 5000.0f;        // Venues silent this long are left out of scans (0 = never)
 bool g_auto_inject_opportunities = false;
+float g_injection_rate = 2.0f;          // Auto-injected dislocations per second
+float g_injection_magnitude = 0.5f;     // Peak price shift (%)
+float g_injection_duration = 2.0f;      // Lifetime of a dislocation (s)
+double g_injection_backlog = 0.0;       // Fractional dislocations carried to the next frame
 int g_update_counter = 0;
 
+// Tick arrival settings
+int g_tick_mode = 0;        // 0 = synchronous (every venue once per second), 1 = Poisson, 2 = Hawkes
+float g_tick_rate = 2.0f;   // Mean ticks per second per symbol/venue
+float g_hawkes_branching = 0.8f;
+bool g_feed_thread = true;  // Generate/replay quotes on the feed handler thread
+bool g_conflate = true;     // Keep only the latest quote per cell when the ring backs up
+bool g_order_books = false; // Maintain L2 books and size opportunities against depth
+bool g_correlated = false;  // Correlated GBM + jumps with cointegrated venues (synchronous updates)
+
 // Globe view settings
 bool g_show_globe = true;
 int g_globe_width = 800;
@@ -263,6 +296,113 @@ void render_historical_playback() {
     ImGui::End();
 }
 
+/**
+ * Arrival process selected in the UI (nullopt = synchronous updates)
+ */
+std::optional<ArrivalParams> selected_arrival_params() {
+    if (g_tick_mode == 2) {
+        // Keep the mean rate at g_tick_rate: mu = rate * (1 - alpha / beta)
+        double beta = 10.0;
+        return ArrivalParams::hawkes(g_tick_rate * (1.0 - g_hawkes_branching), g_hawkes_branching * beta, beta);
+    }
+    if (g_tick_mode == 1) {
+        return ArrivalParams::poisson(g_tick_rate);
+    }
+    return std::nullopt;
+}
+
+/**
+ * (Re)start the event-driven tick model with the current UI settings
+ */
+void configure_tick_model() {
+    auto params = selected_arrival_params();
+    if (!params) return;
+    g_tick_model = TickArrivalModel(g_price_feed.get_seed());
+    g_tick_model.initialize(g_price_feed.num_symbols(), g_price_feed.num_venues(), *params, glfwGetTime());
+}
+
+/**
+ * Stop the feed handler thread and restart it with the current settings
+ * The source is only touched while the thread is stopped, so the UI never
+ * shares mutable state with it.
+ */
+void restart_feed_handler() {
+    g_feed_handler.stop();
+    g_feed_handler.drain_into(g_price_feed);
+    if (!g_feed_thread) return;
+    if (g_conflate) g_feed_handler.enable_conflation(g_price_feed.num_symbols(), g_price_feed.num_venues());
+    else g_feed_handler.disable_conflation();
+    g_feed_handler.track_sequences(g_price_feed.num_venues());
+    
+    if (g_replay_active) {
+        g_feed_handler.start([](FeedHandler& out) { return g_replay.pump(out); });
+        return;
+    }
+    if (!g_feed_source) return;
+    g_feed_source->set_arrivals(selected_arrival_params());
+    if (g_volatility_overridden) {
+        g_feed_source->get_feed().set_volatility(g_volatility);
+    }
+    if (g_correlated != g_feed_source->get_feed().has_correlated_model()) {
+        if (g_correlated) g_feed_source->get_feed().enable_correlated_model(CorrelationParams());
+        else g_feed_source->get_feed().disable_correlated_model();
+    }
+    auto source = g_feed_source;
+    g_feed_handler.start([source](FeedHandler& out) { return (*source)(out); });
+}
+
+/**
+ * Checkpoint the simulation: the consumer feed, the handler thread's
+ * simulated market and the dislocation schedule
+ * The handler thread is stopped around the save so the producer's
+ * generator state is consistent with the quotes already drained.
+ */
+bool save_checkpoint(const std::string& path) {
+    g_feed_handler.stop();
+    g_feed_handler.drain_into(g_price_feed);
+    PriceFeed* producer = g_feed_source ? &g_feed_source->get_feed() : nullptr;
+    bool ok = save_feed_checkpoint(path, g_price_feed, producer, &g_dislocations);
+    restart_feed_handler();
+    std::cout << (ok ? "Saved checkpoint to " : "Failed to save checkpoint to ") << path << std::endl;
+    return ok;
+}
+
+/**
+ * Resume from a checkpoint; UI settings follow the restored feed
+ */
+bool load_checkpoint(const std::string& path) {
+    if (g_replay_active || g_shm_active) {
+        std::cerr << "Checkpoints can only be resumed into the simulated feed" << std::endl;
+        return false;
+    }
+    g_feed_handler.stop();
+    g_feed_handler.drain_into(g_price_feed);
+    PriceFeed* producer = g_feed_source ? &g_feed_source->get_feed() : nullptr;
+    if (!load_feed_checkpoint(path, g_price_feed, producer, &g_dislocations)) {
+        std::cerr << "Failed to load checkpoint " << path << std::endl;
+        restart_feed_handler();
+        return false;
+    }
+    
+    // A checkpoint without a producer section may hold another universe
+    if (producer && (producer->num_symbols() != g_price_feed.num_symbols() ||
+                     producer->num_venues() != g_price_feed.num_venues())) {
+        std::vector<SymbolSpec> universe;
+        for (size_t s = 0; s < g_price_feed.num_symbols(); s++) universe.push_back(g_price_feed.get_symbol(s));
+        g_feed_source = std::make_shared<SimulatedFeedSource>(g_price_feed.get_seed(), g_network.get_exchanges(),
+                                                              universe, selected_arrival_params());
+    }
+    g_correlated = g_price_feed.has_correlated_model();
+    g_order_books = g_price_feed.has_order_books();
+    if (g_selected_symbol >= (int)g_price_feed.num_symbols()) g_selected_symbol = 0;
+    if (g_scanner) g_scanner->invalidate();
+    configure_tick_model();
+    restart_feed_handler();
+    std::cout << "Resumed from checkpoint " << path << " (" << g_price_feed.num_symbols() << " symbols, "
+              << g_dislocations.active() + g_dislocations.pending() << " dislocations)" << std::endl;
+    return true;
+}
+
 /**
  * Render Performance Metrics UI
  */
@@ -292,6 +432,31 @@ void render_performance_metrics() {
         ImGui::Text("Executable: %d", scanner_stats.executable_opportunities);
     }
     
+    const VenueHealth& health = g_price_feed.get_venue_health();
+    ImGui::Text("Masked Venues: %zu (%llu gaps, %llu missed)", health.num_masked(),
+                (unsigned long long)health.total_gaps(), (unsigned long long)health.total_missed());
+    
+    if (g_shm_active) {
+        ImGui::Text("Shared-memory Quotes: %llu", (unsigned long long)g_shm_feed.quotes_consumed());
+        ImGui::Text("Ring: %zu / %zu queued", g_shm_feed.queued(), g_shm_feed.capacity());
+        ImGui::Text("Publisher Drops: %llu", (unsigned long long)g_shm_feed.publisher_dropped());
+    } else if (g_feed_handler.is_running()) {
+        ImGui::Text("Ingest: %.0f quotes/s", g_feed_handler.ingest_rate());
+        ImGui::Text("Ring: %zu / %zu queued", g_feed_handler.queued(), g_feed_handler.capacity());
+        ImGui::Text("Producer Stalls: %llu", (unsigned long long)g_feed_handler.total_stalls());
+        if (g_feed_handler.conflating()) {
+            ImGui::Text("Conflated: %llu", (unsigned long long)g_feed_handler.total_conflated());
+        }
+    } else if (g_tick_mode != 0) {
+        ImGui::Text("Event Ticks: %llu", (unsigned long long)g_tick_model.get_total_ticks());
+    }
+    
+    if (TscClock::uses_tsc()) {
+        ImGui::Text("Clock: TSC %.2f GHz", TscClock::tsc_ghz());
+    } else {
+        ImGui::Text("Clock: steady_clock");
+    }
+    
     ImGui::End();
 }
 
@@ -307,8 +472,7 @@ void render_exchange_tooltip() {
         const auto& exchanges = g_network.get_exchanges();
         if (hovered < (int)exchanges.size()) {
             const auto& ex = exchanges[hovered];
-            const auto& prices = g_price_feed.get_all_prices();
-            auto price_it = prices.find(ex.id);
+            auto quote = g_price_feed.get_price(ex.id, g_selected_symbol);
             
             // Position tooltip near mouse
             ImGui::SetNextWindowPos(ImVec2(g_mouse_x + 15, g_mouse_y + 15));
@@ -328,12 +492,13 @@ void render_exchange_tooltip() {
             ImGui::Text("Type: %s", ex.get_type_string().c_str());
             ImGui::Text("Location: %.2f°, %.2f°", ex.latitude, ex.longitude);
             
-            if (price_it != prices.end()) {
+            if (quote) {
                 ImGui::Separator();
-                ImGui::Text("Bid: $%.2f", price_it->second.bid);
-                ImGui::Text("Ask: $%.2f", price_it->second.ask);
+                ImGui::Text("Symbol: %s", g_price_feed.get_symbol(g_selected_symbol).name.c_str());
+                ImGui::Text("Bid: $%.2f", quote->bid_price());
+                ImGui::Text("Ask: $%.2f", quote->ask_price());
                 ImGui::Text("Spread: %.2f bps", 
-                          (price_it->second.spread() / price_it->second.mid_price()) * 10000);
+                          (quote->spread() / quote->mid_price()) * 10000);
             }
             
             ImGui::Text(" ");
@@ -375,38 +540,37 @@ void render_globe_view() {
 }
 
 /**
- * Load exchanges from JSON file
+ * Checksum of a file's contents (0 if it cannot be read)
+ * Used to detect when a cached network snapshot is stale
  */
-bool load_exchanges(const std::string& filepath, NetworkGraph& network) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open: " << filepath << std::endl;
-        return false;
-    }
-    
-    json data;
-    file >> data;
-    
-    if (!data.contains("exchanges")) {
-        std::cerr << "Invalid JSON: missing 'exchanges' field" << std::endl;
-        return false;
-    }
-    
-    for (const auto& ex_json : data["exchanges"]) {
-        std::string id = ex_json["id"];
-        std::string name = ex_json["name"];
-        std::string city = ex_json["city"];
-        double lat = ex_json["lat"];
-        double lon = ex_json["lon"];
-        std::string type_str = ex_json["type"];
-        
-        ExchangeType type = string_to_exchange_type(type_str);
-        Exchange ex(id, name, city, lat, lon, type);
-        network.add_exchange(ex);
-    }
-    
-    std::cout << "Loaded " << network.get_exchanges().size() << " exchanges" << std::endl;
-    return true;
+uint64_t file_checksum(const std::string& filepath) {
+    MappedFile file;
+    if (!file.open(filepath)) return 0;
+    return checksum64(file.data(), file.size());
+}
+
+/**
+ * Fold the feed's pending changes into the scanner's set and start a new epoch
+ */
+void collect_feed_changes() {
+    g_scan_changes.merge(g_price_feed.get_changes());
+    g_price_feed.clear_changes();
+}
+
+/**
+ * Ranked opportunities for the feed as it stands
+ * The scanner rescans (incrementally) only when the feed epoch or a
+ * setting moved since its last scan, so every panel drawing this frame
+ * gets the same shared list for the cost of one scan. Hold the returned
+ * pointer for as long as the list is read.
+ */
+ArbitrageScanner::OpportunityList current_opportunities() {
+    static const ArbitrageScanner::OpportunityList none = std::make_shared<const std::vector<ArbitrageOpportunity>>();
+    if (!g_scanner) return none;
+    collect_feed_changes();
+    auto opportunities = g_scanner->latest_opportunities(g_scan_changes);
+    g_scan_changes.clear();
+    return opportunities;
 }
 
 /**
@@ -416,9 +580,25 @@ void render_exchange_table() {
     ImGui::Begin("Exchange Network", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
     
     const auto& exchanges = g_network.get_exchanges();
-    const auto& prices = g_price_feed.get_all_prices();
     
     ImGui::Text("Total Exchanges: %zu", exchanges.size());
+    
+    // Symbol selector (table shows one symbol row of the quote matrix)
+    if (g_price_feed.num_symbols() > 0) {
+        const char* current = g_price_feed.get_symbol(g_selected_symbol).name.c_str();
+        if (ImGui::BeginCombo("Symbol", current)) {
+            for (size_t s = 0; s < g_price_feed.num_symbols(); s++) {
+                bool is_selected = (g_selected_symbol == (int)s);
+                if (ImGui::Selectable(g_price_feed.get_symbol(s).name.c_str(), is_selected)) {
+                    g_selected_symbol = s;
+                }
+                if (is_selected) {
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+    }
     ImGui::Separator();
     
     if (ImGui::BeginTable("ExchangeTable", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0, 300))) {
@@ -432,7 +612,7 @@ void render_exchange_table() {
         ImGui::TableHeadersRow();
         
         for (const auto& ex : exchanges) {
-            auto price_it = prices.find(ex.id);
+            auto quote = g_price_feed.get_price(ex.id, g_selected_symbol);
             
             ImGui::TableNextRow();
             ImGui::TableNextColumn();
@@ -447,16 +627,15 @@ void render_exchange_table() {
             ImGui::TableNextColumn();
             ImGui::Text("%s", ex.get_type_string().c_str());
             
-            if (price_it != prices.end()) {
-                const auto& quote = price_it->second;
+            if (quote) {
                 ImGui::TableNextColumn();
-                ImGui::Text("$%.2f", quote.bid);
+                ImGui::Text("$%.2f", quote->bid_price());
                 
                 ImGui::TableNextColumn();
-                ImGui::Text("$%.2f", quote.ask);
+                ImGui::Text("$%.2f", quote->ask_price());
                 
                 ImGui::TableNextColumn();
-                ImGui::Text("%.2f bps", (quote.spread() / quote.mid_price()) * 10000);
+                ImGui::Text("%.2f bps", (quote->spread() / quote->mid_price()) * 10000);
             } else {
                 ImGui::TableNextColumn();
                 ImGui::Text("N/A");
@@ -569,19 +748,88 @@ void render_arbitrage_opportunities() {
     ImGui::Separator();
     
     // Controls
-    ImGui::SliderFloat("Volatility", &g_volatility, 0.0f, 0.1f, "%.4f");
+    if (ImGui::SliderFloat("Volatility", &g_volatility, 0.0f, 0.1f, "%.4f")) {
+        // Overrides the per-symbol volatilities from the universe file
+        g_price_feed.set_volatility(g_volatility);
+        g_volatility_overridden = true;
+    }
+    // The handler thread picks the new volatility up once the drag ends
+    if (ImGui::IsItemDeactivatedAfterEdit() && g_feed_thread) {
+        restart_feed_handler();
+    }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Higher = more price movement");
+        ImGui::SetTooltip("Higher = more price movement (applies to all symbols)");
     }
     
     ImGui::SliderFloat("Min Profit (bps)", &g_min_profit_bps, 1.0f, 50.0f);
     ImGui::SliderFloat("Trading Fee (%)", &g_trading_fee, 0.0f, 1.0f, "%.2f");
     ImGui::SliderFloat("Opportunity Window (ms)", &g_opportunity_window, 50.0f, 1000.0f);
+    ImGui::SliderFloat("Stale Venue (ms)", &g_stale_after_ms, 0.0f, 30000.0f, "%.0f");
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Leave out venues with no update for this long, or with a recent sequence gap (0 = never stale)");
+    }
+    
+    const char* tick_modes[] = { "Synchronous", "Poisson", "Hawkes" };
+    bool tick_changed = ImGui::Combo("Tick Arrivals", &g_tick_mode, tick_modes, IM_ARRAYSIZE(tick_modes));
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Poisson/Hawkes: every symbol/venue ticks on its own random clock");
+    }
+    if (g_tick_mode != 0) {
+        tick_changed |= ImGui::SliderFloat("Tick Rate (/s)", &g_tick_rate, 0.1f, 50.0f, "%.1f");
+        if (g_tick_mode == 2) {
+            tick_changed |= ImGui::SliderFloat("Self-excitation", &g_hawkes_branching, 0.0f, 0.95f, "%.2f");
+        }
+    }
+    if (tick_changed) {
+        configure_tick_model();
+        if (g_feed_thread) restart_feed_handler();
+    }
+    
+    if (ImGui::Checkbox("Correlated Assets", &g_correlated)) {
+        if (g_correlated) g_correlated = g_price_feed.enable_correlated_model(CorrelationParams());
+        else g_price_feed.disable_correlated_model();
+        if (g_feed_thread) restart_feed_handler();
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Correlated GBM with jumps across symbols; venues mean-revert to a common fair value");
+    }
+    
+    if (ImGui::Checkbox("Feed Handler Thread", &g_feed_thread)) {
+        restart_feed_handler();
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Generate or replay quotes on a separate thread; the scanner drains them each frame");
+    }
+    if (g_feed_thread) {
+        if (ImGui::Checkbox("Conflate Backlog", &g_conflate)) {
+            restart_feed_handler();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("When the ring is full keep only the latest quote per symbol/venue instead of stalling the feed");
+        }
+    }
+    
+    if (ImGui::Checkbox("Order Book Depth", &g_order_books)) {
+        if (g_order_books) {
+            g_price_feed.enable_order_books(10);
+        } else {
+            g_price_feed.disable_order_books();
+        }
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Keep a 10-level book per venue and size each opportunity against its depth");
+    }
     
     ImGui::Checkbox("Auto-inject Opportunities", &g_auto_inject_opportunities);
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Automatically create price discrepancies for testing");
+        ImGui::SetTooltip("Automatically create transient price discrepancies for testing");
     }
+    if (g_auto_inject_opportunities) {
+        ImGui::SliderFloat("Injections (/s)", &g_injection_rate, 0.1f, 10000.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+    }
+    ImGui::SliderFloat("Dislocation (%)", &g_injection_magnitude, 0.05f, 2.0f, "%.2f");
+    ImGui::SliderFloat("Dislocation Life (s)", &g_injection_duration, 0.05f, 10.0f, "%.2f");
+    ImGui::Text("Dislocations: %zu live, %zu pending", g_dislocations.active(), g_dislocations.pending());
     
     if (ImGui::Button("Manual Price Update")) {
         g_price_feed.update_prices();
@@ -589,44 +837,83 @@ void render_arbitrage_opportunities() {
     ImGui::SameLine();
     if (ImGui::Button("Inject Arbitrage")) {
         const auto& exchanges = g_network.get_exchanges();
-        if (!exchanges.empty()) {
-            int random_idx = rand() % exchanges.size();
-            g_price_feed.inject_arbitrage_opportunity(exchanges[random_idx].id, 0.5);
+        int venue = exchanges.empty() ? -1 : g_price_feed.get_venue_handle(exchanges[rand() % exchanges.size()].id);
+        if (venue >= 0) {
+            DislocationSpec spec;
+            spec.symbol = g_selected_symbol;
+            spec.venue = venue;
+            spec.magnitude = g_injection_magnitude / 100.0;
+            spec.duration_ns = static_cast<uint64_t>(g_injection_duration * 1e9);
+            spec.curve = DecayCurve::LINEAR;
+            g_dislocations.schedule(spec, g_price_feed.now_ns());
+        }
+    }
+    
+    if (ImGui::Button("Save Checkpoint")) {
+        save_checkpoint(CHECKPOINT_PATH);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Load Checkpoint")) {
+        load_checkpoint(CHECKPOINT_PATH);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Quotes, generator state and pending dislocations (%s)", CHECKPOINT_PATH);
+    }
+    
+    // Observer site: remote quotes arrive delayed by the network latency
+    const char* observer_label = g_observer_exchange.empty() ? "(instant prices)" : g_observer_exchange.c_str();
+    if (ImGui::BeginCombo("Observer", observer_label)) {
+        if (ImGui::Selectable("(instant prices)", g_observer_exchange.empty())) {
+            g_observer_exchange.clear();
+        }
+        for (const auto& ex : g_network.get_exchanges()) {
+            if (ImGui::Selectable(ex.id.c_str(), g_observer_exchange == ex.id)) {
+                g_observer_exchange = ex.id;
+            }
         }
+        ImGui::EndCombo();
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Scan as seen from a colocation site: each venue's quote is delayed by its latency");
     }
     
     // Update scanner settings
     if (g_scanner) {
+        g_scanner->set_observer(g_observer_exchange);
         g_scanner->set_min_profit_bps(g_min_profit_bps);
         g_scanner->set_trading_fee(g_trading_fee);
         g_scanner->set_opportunity_window(g_opportunity_window);
     }
-    
-    g_price_feed.set_volatility(g_volatility);
+    g_price_feed.get_venue_health().set_stale_after_ns(static_cast<uint64_t>(g_stale_after_ms * 1e6));
     
     ImGui::Separator();
     
-    // Get opportunities
-    auto opportunities = g_scanner ? g_scanner->get_top_opportunities(20) : std::vector<ArbitrageOpportunity>();
+    // Get opportunities (top 20 are listed)
+    ArbitrageScanner::OpportunityList opportunities = current_opportunities();
+    size_t listed = std::min<size_t>(opportunities->size(), 20);
     
-    ImGui::Text("Found %zu opportunities", opportunities.size());
+    ImGui::Text("Found %zu opportunities", opportunities->size());
     
     // Opportunities table
-    if (ImGui::BeginTable("OpportunitiesTable", 8, 
+    if (ImGui::BeginTable("OpportunitiesTable", 11, 
         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, 
         ImVec2(0, 400))) {
         
+        ImGui::TableSetupColumn("Symbol");
         ImGui::TableSetupColumn("Buy");
         ImGui::TableSetupColumn("Sell");
         ImGui::TableSetupColumn("Profit %");
         ImGui::TableSetupColumn("Est. Profit $");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Depth $");
         ImGui::TableSetupColumn("Latency");
         ImGui::TableSetupColumn("RTT");
         ImGui::TableSetupColumn("Window");
         ImGui::TableSetupColumn("Status");
         ImGui::TableHeadersRow();
         
-        for (const auto& opp : opportunities) {
+        for (size_t i = 0; i < listed; i++) {
+            const auto& opp = (*opportunities)[i];
             ImGui::TableNextRow();
             
             // Color code by profitability
@@ -635,6 +922,9 @@ void render_arbitrage_opportunities() {
                     ImGui::GetColorU32(ImVec4(0.0f, 0.3f, 0.0f, 0.3f)));
             }
             
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", opp.symbol.c_str());
+            
             ImGui::TableNextColumn();
             ImGui::Text("%s", opp.buy_exchange.c_str());
             
@@ -647,6 +937,20 @@ void render_arbitrage_opportunities() {
             ImGui::TableNextColumn();
             ImGui::Text("$%.2f", opp.estimated_profit);
             
+            ImGui::TableNextColumn();
+            if (g_price_feed.has_order_books()) {
+                ImGui::Text("%.0f", opp.executable_size);
+            } else {
+                ImGui::TextDisabled("-");
+            }
+            
+            ImGui::TableNextColumn();
+            if (g_price_feed.has_order_books()) {
+                ImGui::Text("$%.2f", opp.depth_profit);
+            } else {
+                ImGui::TextDisabled("-");
+            }
+            
             ImGui::TableNextColumn();
             ImGui::Text("%.1f ms", opp.latency_ms);
             
@@ -660,7 +964,7 @@ void render_arbitrage_opportunities() {
             if (opp.is_executable) {
                 ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "✓ GO");
                 ImGui::SameLine();
-                if (ImGui::SmallButton(("Execute##" + opp.buy_exchange + opp.sell_exchange).c_str())) {
+                if (ImGui::SmallButton(("Execute##" + opp.symbol + opp.buy_exchange + opp.sell_exchange).c_str())) {
                     // Simulate trade execution
                     g_trading_stats.total_trades++;
                     
@@ -674,11 +978,11 @@ void render_arbitrage_opportunities() {
                         // Update best trade
                         if (opp.estimated_profit > g_trading_stats.best_trade_profit) {
                             g_trading_stats.best_trade_profit = opp.estimated_profit;
-                            g_trading_stats.best_trade_route = opp.buy_exchange + " → " + opp.sell_exchange;
+                            g_trading_stats.best_trade_route = opp.symbol + " " + opp.buy_exchange + " → " + opp.sell_exchange;
                         }
                     }
                     
-                    std::cout << "✓ Executed trade: " << opp.buy_exchange << " -> " << opp.sell_exchange 
+                    std::cout << "✓ Executed trade: " << opp.symbol << " " << opp.buy_exchange << " -> " << opp.sell_exchange 
                               << " | Profit: $" << opp.estimated_profit << std::endl;
                 }
             } else {
@@ -720,9 +1024,33 @@ void render_trading_stats() {
     ImGui::End();
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::cout << "Latency Arbitrage Simulator - Initializing..." << std::endl;
     
+    // Optional recorded-tick replay: --replay <file.ticks> [--speed <x> | --max]
+    // or a live shared-memory feed:  --shm <ring name>
+    // Resume a saved simulation:     --resume <checkpoint>
+    std::string replay_path;
+    std::string shm_name;
+    std::string resume_path;
+    ReplayPace replay_pace = ReplayPace::REAL_TIME;
+    double replay_speed = 1.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            replay_pace = ReplayPace::ACCELERATED;
+            replay_speed = std::atof(argv[++i]);
+        } else if (arg == "--max") {
+            replay_pace = ReplayPace::AS_FAST_AS_POSSIBLE;
+        } else if (arg == "--shm" && i + 1 < argc) {
+            shm_name = argv[++i];
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resume_path = argv[++i];
+        }
+    }
+    
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -773,22 +1101,95 @@ int main() {
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
     
-    // Load exchange data
-    if (!load_exchanges("../data/exchanges.json", g_network)) {
-        std::cerr << "Failed to load exchanges!" << std::endl;
-        return -1;
+    // Load network from binary snapshot (rebuilt if exchanges.json changed)
+    uint64_t exchanges_hash = file_checksum("../data/exchanges.json");
+    if (g_network.load_snapshot("../data/network_graph.bin", exchanges_hash)) {
+        std::cout << "Loaded network snapshot (" << g_network.get_exchanges().size()
+                  << " exchanges)" << std::endl;
+    } else {
+        // Load exchange data
+        if (!load_exchanges("../data/exchanges.json", g_network)) {
+            std::cerr << "Failed to load exchanges!" << std::endl;
+            return -1;
+        }
+        
+        // Build network connections
+        g_network.connect_all_exchanges(TransmissionMedium::FIBER_OPTIC);
+        std::cout << "Network graph built successfully!" << std::endl;
+        
+        if (!g_network.save_snapshot("../data/network_graph.bin", exchanges_hash)) {
+            std::cerr << "Warning: could not write network snapshot" << std::endl;
+        }
+    }
+    
+    // Initialize price feeds (single BTC/USD feed if no universe file)
+    std::vector<SymbolSpec> universe;
+    if (load_symbol_universe("../data/symbols.json", universe)) {
+        g_price_feed.initialize_feeds(g_network.get_exchanges(), universe);
+    } else {
+        g_price_feed.initialize_feeds(g_network.get_exchanges());
+    }
+    
+    // Replay: quote exactly the recorded symbols, starting empty
+    if (!replay_path.empty()) {
+        if (g_replay.open(replay_path)) {
+            std::vector<SymbolSpec> replay_universe;
+            for (const auto& name : g_replay.get_file().symbols()) {
+                replay_universe.push_back(SymbolSpec::external(name, universe));
+            }
+            g_price_feed.initialize_feeds(g_network.get_exchanges(), replay_universe);
+            size_t matched_venues = 0;
+            g_replay.bind(g_price_feed);
+            for (const auto& venue : g_replay.get_file().venues()) {
+                if (g_price_feed.get_venue_handle(venue) >= 0) matched_venues++;
+            }
+            g_replay.set_pace(replay_pace, replay_speed);
+            g_replay.start();
+            g_replay_active = true;
+            std::cout << "Replaying " << g_replay.size() << " ticks from " << replay_path
+                      << " (" << matched_venues << "/" << g_replay.get_file().venues().size()
+                      << " venues known)" << std::endl;
+        } else {
+            std::cerr << "Failed to open tick file: " << replay_path << std::endl;
+        }
     }
     
-    // Build network connections
-    g_network.connect_all_exchanges(TransmissionMedium::FIBER_OPTIC);
-    std::cout << "Network graph built successfully!" << std::endl;
+    // Shared-memory feed: quote the publisher's symbols, starting empty
+    if (!shm_name.empty() && !g_replay_active) {
+        if (g_shm_feed.open(shm_name)) {
+            std::vector<SymbolSpec> shm_universe;
+            for (const auto& name : g_shm_feed.symbols()) {
+                shm_universe.push_back(SymbolSpec::external(name, universe));
+            }
+            g_price_feed.initialize_feeds(g_network.get_exchanges(), shm_universe);
+            g_shm_feed.bind(g_price_feed);
+            g_shm_active = true;
+            std::cout << "Attached to shared-memory feed " << shm_name << " (" << g_shm_feed.symbols().size()
+                      << " symbols x " << g_shm_feed.venues().size() << " venues)" << std::endl;
+        } else {
+            std::cerr << "No shared-memory feed named " << shm_name << " (start feed_publisher first)" << std::endl;
+        }
+    }
     
-    // Initialize price feeds
-    g_price_feed.initialize_feeds(g_network.get_exchanges());
-    std::cout << "Price feeds initialized!" << std::endl;
+    g_price_feed.enable_history(4096, 250000); // ~1 s of quotes at 250 us resolution for delayed views
+    std::cout << "Price feeds initialized! (" << g_price_feed.num_symbols() << " symbols)" << std::endl;
+    g_dislocations = DislocationEngine(g_price_feed.get_seed());
+    
+    // Producer-side copy of the simulated market for the feed handler thread
+    if (!g_replay_active && !g_shm_active) {
+        std::vector<SymbolSpec> feed_universe;
+        for (size_t s = 0; s < g_price_feed.num_symbols(); s++) {
+            feed_universe.push_back(g_price_feed.get_symbol(s));
+        }
+        g_feed_source = std::make_shared<SimulatedFeedSource>(g_price_feed.get_seed(), g_network.get_exchanges(),
+                                                              feed_universe, selected_arrival_params());
+    }
+    restart_feed_handler();
+    if (!resume_path.empty()) load_checkpoint(resume_path);
     
     // Initialize arbitrage scanner
     g_scanner = new ArbitrageScanner(g_network, g_price_feed);
+    g_scanner->set_worker_threads(std::thread::hardware_concurrency());   // Symbols / venue-pair tiles on every core
     std::cout << "Arbitrage scanner ready!" << std::endl;
     
     // Initialize co-location optimizer
@@ -821,25 +1222,64 @@ int main() {
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         
+        // Quotes from the feed handler thread (simulated or replayed)
+        bool threaded = g_feed_handler.is_running();
+        if (threaded) {
+            g_feed_handler.drain_into(g_price_feed);
+        }
+        
+        // Recorded ticks replace the simulated feed while a replay runs
+        bool replaying = g_replay_active || g_shm_active;
+        if (g_replay_active && !threaded) {
+            g_replay.pump(g_price_feed);
+        }
+        
+        // Quotes are applied straight from the publisher's shared-memory slots
+        if (g_shm_active) {
+            g_shm_feed.drain_into(g_price_feed);
+        }
+        
+        // Event-driven ticks up to the current wall time
+        if (g_tick_mode != 0 && !replaying && !threaded) {
+            // Stamp each event at its own arrival time (model time runs on glfwGetTime)
+            uint64_t now_ns = TscClock::now_ns();
+            double now_s = glfwGetTime();
+            g_tick_model.advance_until(now_s, [now_ns, now_s](const TickEvent& event) {
+                g_price_feed.apply_tick(event.symbol, event.venue,
+                                        now_ns - static_cast<uint64_t>((now_s - event.time) * 1e9));
+            });
+        }
+        
+        // Auto-inject transient dislocations, spread over the coming frame
+        uint64_t frame_ns = g_price_feed.now_ns();
+        if (g_auto_inject_opportunities) {
+            g_injection_backlog += g_injection_rate * ImGui::GetIO().DeltaTime;
+            size_t count = static_cast<size_t>(g_injection_backlog);
+            g_injection_backlog -= count;
+            double magnitude = g_injection_magnitude / 100.0;
+            uint64_t duration_ns = static_cast<uint64_t>(g_injection_duration * 1e9);
+            g_dislocations.schedule_random(g_price_feed, count, frame_ns,
+                                           static_cast<uint64_t>(ImGui::GetIO().DeltaTime * 1e9),
+                                           magnitude * 0.2, magnitude, duration_ns / 4, duration_ns);
+        }
+        g_dislocations.advance(g_price_feed, frame_ns);
+        
+        // Stale or gapped venues drop out of this frame's scans
+        g_price_feed.refresh_venue_health(frame_ns);
+        
+        // Delayed (observer) views are taken as of the frame start, so every panel shares one scan
+        if (g_scanner) g_scanner->set_view_time(frame_ns);
+        
         // Update prices periodically
         g_update_counter++;
         if (g_update_counter % 60 == 0) {  // Every 60 frames (~1 second at 60 FPS)
-            g_price_feed.update_prices();
-            
-            // Record historical data
-            if (g_historical_tracker) {
-                auto opportunities = g_scanner->scan_opportunities();
-                g_historical_tracker->record(opportunities);
+            if (g_tick_mode == 0 && !replaying && !threaded) {
+                g_price_feed.update_prices();
             }
             
-            // Auto-inject opportunities for demo
-            if (g_auto_inject_opportunities && g_update_counter % 180 == 0) {
-                const auto& exchanges = g_network.get_exchanges();
-                if (!exchanges.empty()) {
-                    int random_idx = rand() % exchanges.size();
-                    double deviation = (rand() % 100) / 100.0;
-                    g_price_feed.inject_arbitrage_opportunity(exchanges[random_idx].id, deviation);
-                }
+            // Record historical data (the same scan the panels draw this frame)
+            if (g_historical_tracker) {
+                g_historical_tracker->record(current_opportunities());
             }
         }
         
@@ -855,7 +1295,8 @@ int main() {
             
             // Render globe to full screen background
             glViewport(0, 0, display_w, display_h);
-            auto opportunities = g_scanner ? g_scanner->get_top_opportunities(10) : std::vector<ArbitrageOpportunity>();
+            ArbitrageScanner::OpportunityList all = current_opportunities();
+            std::vector<ArbitrageOpportunity> opportunities(all->begin(), all->begin() + std::min<size_t>(all->size(), 10));
             g_globe_renderer->render(g_network.get_exchanges(), opportunities, display_w, display_h, true);
         }
         
@@ -895,9 +1336,13 @@ int main() {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         
         glfwSwapBuffers(window);
+        
+        // Every consumer has seen this frame's changes
+        collect_feed_changes();
     }
     
     // Cleanup
+    g_feed_handler.stop();
     delete g_scanner;
     delete g_globe_renderer;
     delete g_colocation_optimizer;
@@ -0,0 +1,161 @@
+// Checkpoint round trip and rejection of corrupt feed and dislocation state
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include "price_feed.h"
+#include "dislocation_engine.h"
+#include "feed_checkpoint.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+template <typename T>
+static void patch(std::vector<char>& state, size_t offset, T value) {
+    std::memcpy(state.data() + offset, &value, sizeof(T));
+}
+
+static std::vector<Exchange> test_exchanges() {
+    std::vector<Exchange> exchanges;
+    for (int v = 0; v < 4; v++) {
+        exchanges.emplace_back("V" + std::to_string(v), "Venue", "City", 0.0, 0.0, ExchangeType::CRYPTO);
+    }
+    return exchanges;
+}
+
+static void test_feed_state() {
+    PriceFeed feed(42);
+    feed.initialize_feeds(test_exchanges(), std::vector<SymbolSpec>{ SymbolSpec("AAA", 100.0, 0.001, 0.01),
+                                                                     SymbolSpec("BBB", 50.0, 0.001, 0.01) });
+    feed.enable_order_books(4);
+    feed.update_prices();
+    
+    BinaryWriter writer;
+    feed.write_state(writer);
+    std::vector<char> state(writer.data(), writer.data() + writer.size());
+    
+    {
+        PriceFeed restored(1);
+        BinaryReader reader(state.data(), state.size());
+        check(restored.read_state(reader), "intact feed state restores");
+        check(restored.num_symbols() == 2 && restored.num_venues() == 4, "restored dimensions");
+        check(restored.has_order_books(), "restored books");
+    }
+    
+    // Books are the last section; the first book's bid side starts it
+    size_t books_bytes = feed.num_symbols() * feed.num_venues() * sizeof(OrderBook);
+    patch<uint32_t>(state, state.size() - books_bytes + offsetof(BookLevels, count), OrderBook::MAX_LEVELS + 1);
+    {
+        PriceFeed restored(1);
+        BinaryReader reader(state.data(), state.size());
+        check(!restored.read_state(reader), "book level count past MAX_LEVELS is rejected");
+    }
+}
+
+static void test_dislocation_state() {
+    PriceFeed feed(42);
+    feed.initialize_feeds(test_exchanges(), std::vector<SymbolSpec>{ SymbolSpec("AAA", 100.0, 0.001, 0.01) });
+    
+    // Slots 0 and 1 expire and are freed; slot 2 stays live
+    DislocationEngine engine(7, 1000000);
+    uint64_t start = 1000000000000ULL;
+    DislocationSpec spec;
+    spec.duration_ns = 5000000;
+    engine.schedule(spec, start);
+    spec.venue = 1;
+    engine.schedule(spec, start);
+    spec.venue = 2;
+    spec.duration_ns = 1000000000;
+    engine.schedule(spec, start);
+    engine.advance(feed, start + 20000000);
+    check(engine.active() == 1, "one dislocation left live");
+    
+    BinaryWriter writer;
+    engine.write_state(writer);
+    std::vector<char> state(writer.data(), writer.data() + writer.size());
+    {
+        DislocationEngine restored;
+        BinaryReader reader(state.data(), state.size());
+        check(restored.read_state(reader) && restored.active() == 1, "intact dislocation state restores");
+    }
+    
+    // 8 header words, slot count, 3 slots of 48 bytes, free count, free ids
+    const size_t slot_bytes = 2 * sizeof(int32_t) + sizeof(double) + sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+                              sizeof(uint64_t) + sizeof(double);
+    const size_t free_ids = 9 * sizeof(uint64_t) + 3 * slot_bytes + sizeof(uint64_t);
+    struct Case {
+        uint32_t first;
+        uint32_t second;
+        const char* what;
+    };
+    const Case cases[] = {
+        { 100, 1, "free slot id past the pool is rejected" },
+        { 2, 1, "live slot listed as free is rejected" },
+        { 0, 0, "slot freed twice is rejected" },
+    };
+    for (const Case& c : cases) {
+        std::vector<char> corrupt = state;
+        patch(corrupt, free_ids, c.first);
+        patch(corrupt, free_ids + sizeof(uint32_t), c.second);
+        DislocationEngine restored;
+        BinaryReader reader(corrupt.data(), corrupt.size());
+        check(!restored.read_state(reader), c.what);
+    }
+}
+
+static void test_checkpoint_file() {
+    PriceFeed feed(42), producer(43);
+    std::vector<SymbolSpec> universe{ SymbolSpec("AAA", 100.0, 0.001, 0.01) };
+    feed.initialize_feeds(test_exchanges(), universe);
+    feed.enable_order_books(4);
+    producer.initialize_feeds(test_exchanges(), universe);
+    producer.update_prices();
+    const std::string path = "feed_checkpoint_test.bin";
+    check(save_feed_checkpoint(path, feed, &producer), "checkpoint saves");
+    
+    // Corrupt the feed section's last book count and re-seal the checksum,
+    // so only the section's own validation can catch it
+    std::vector<char> file;
+    {
+        MappedFile mapped;
+        check(mapped.open(path), "checkpoint maps");
+        file.assign(mapped.data(), mapped.data() + mapped.size());
+    }
+    FeedCheckpointHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    size_t feed_end = sizeof(header) + header.feed_size;
+    patch<uint32_t>(file, feed_end - sizeof(OrderBook) + offsetof(BookLevels, count), OrderBook::MAX_LEVELS + 1);
+    header.payload_checksum = checksum64(file.data() + sizeof(header), file.size() - sizeof(header));
+    std::memcpy(file.data(), &header, sizeof(header));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(file.data(), file.size());
+    }
+    
+    PriceFeed live(1), live_producer(2);
+    live.initialize_feeds(test_exchanges());
+    live_producer.initialize_feeds(test_exchanges());
+    uint64_t producer_tick = live_producer.get_tick();
+    check(!load_feed_checkpoint(path, live, &live_producer), "malformed feed section is rejected");
+    check(live.num_symbols() == 1 && live_producer.num_symbols() == 1 && live_producer.get_tick() == producer_tick,
+          "rejected checkpoint leaves feed and producer unchanged");
+    std::remove(path.c_str());
+}
+
+int main() {
+    test_feed_state();
+    test_dislocation_state();
+    test_checkpoint_file();
+    
+    if (failures) return 1;
+    std::cout << "feed_checkpoint_test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Every scan mode of ArbitrageScanner lists the same opportunities in the same order
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "price_feed.h"
+#include "arbitrage_scanner.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+static bool same(const std::vector<ArbitrageOpportunity>& a, const std::vector<ArbitrageOpportunity>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].symbol != b[i].symbol || a[i].buy_exchange != b[i].buy_exchange ||
+            a[i].sell_exchange != b[i].sell_exchange || a[i].buy_ticks != b[i].buy_ticks ||
+            a[i].sell_ticks != b[i].sell_ticks || a[i].score != b[i].score ||
+            a[i].estimated_profit != b[i].estimated_profit || a[i].is_executable != b[i].is_executable ||
+            a[i].timestamp != b[i].timestamp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Full scan with crossing directions enumerated by sorting, or every pair compared
+ */
+static std::vector<ArbitrageOpportunity> full_scan(ArbitrageScanner& scanner, bool sorted_crosses) {
+    scanner.set_sorted_crosses(sorted_crosses);
+    return scanner.scan_opportunities();
+}
+
+int main() {
+    // More venues than one pair-scan tile, so pair scans cross tile boundaries
+    const size_t symbols = 4, venues = 300;
+    NetworkGraph network;
+    for (size_t v = 0; v < venues; v++) {
+        double latitude = static_cast<double>((v * 37) % 140) - 70.0;
+        double longitude = static_cast<double>((v * 71) % 360) - 180.0;
+        network.add_exchange(Exchange("V" + std::to_string(v), "Venue", "City", latitude, longitude, ExchangeType::CRYPTO));
+    }
+    network.connect_all_exchanges();
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.0008 * (s + 1), 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(network.get_exchanges(), universe);
+    feed.update_prices();
+    
+    ArbitrageScanner incremental(network, feed), threaded_incremental(network, feed);
+    ArbitrageScanner single(network, feed), threaded(network, feed);
+    threaded_incremental.set_worker_threads(4);
+    threaded_incremental.set_sorted_crosses(false);
+    threaded.set_worker_threads(4);
+    ArbitrageScanner* scanners[] = { &incremental, &threaded_incremental, &single, &threaded };
+    
+    CounterRng rng(7);
+    uint64_t t = feed.now_ns();
+    size_t most_found = 0, most_masked = 0;
+    for (int step = 0; step < 120; step++) {
+        for (size_t n = 0; n < 6; n++) {
+            auto r = rng.draw(step * 6 + n, 0, 0, 0);
+            feed.apply_tick(static_cast<int>(r.v[0] % symbols), static_cast<int>(r.v[1] % venues), ++t);
+        }
+        
+        // Settings changes rebuild the incremental table; while venues go
+        // stale, their mask bits flip as they age out and tick back in
+        if (step == 30 || step == 90) {
+            for (ArbitrageScanner* scanner : scanners) scanner->set_min_profit_bps(step == 30 ? 2.0 : 5.0);
+        }
+        feed.get_venue_health().set_stale_after_ns((step >= 40 && step < 100) ? 200 : 0);
+        feed.refresh_venue_health(t);
+        most_masked = std::max(most_masked, feed.get_venue_health().num_masked());
+        
+        std::vector<ArbitrageOpportunity> from_changes = *incremental.scan_opportunities(feed.get_changes());
+        std::vector<ArbitrageOpportunity> from_changes_threaded = *threaded_incremental.scan_opportunities(feed.get_changes());
+        feed.clear_changes();
+        std::vector<ArbitrageOpportunity> crosses = full_scan(single, true);
+        std::vector<ArbitrageOpportunity> pairs = full_scan(single, false);
+        std::vector<ArbitrageOpportunity> crosses_threaded = full_scan(threaded, true);
+        std::vector<ArbitrageOpportunity> pairs_threaded = full_scan(threaded, false);
+        most_found = std::max(most_found, crosses.size());
+        
+        check(same(from_changes, crosses), "incremental scan matches a full scan");
+        check(same(pairs, crosses), "sorted crosses match pair enumeration");
+        check(same(crosses_threaded, crosses) && same(pairs_threaded, pairs) && same(from_changes_threaded, from_changes),
+              "4 scanner threads match 1");
+        if (failures) {
+            std::cerr << "  at step " << step << std::endl;
+            return 1;
+        }
+    }
+    check(most_found > 0, "scans found opportunities");
+    check(most_masked > 0 && most_masked < venues, "some venues were masked");
+    
+    if (failures) return 1;
+    std::cout << "scanner_equivalence_test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,430 @@
+/**
+ * Price feed microbenchmark
+ * Measures venue-quote updates per second of PriceFeed::update_prices on
+ * one core (and optionally with worker threads) for a few universe shapes,
+ * with independent random walks and with the correlated multi-asset model,
+ * event throughput of the asynchronous TickArrivalModel + apply_tick, and
+ * sustained ingest through the FeedHandler ring (producer thread ->
+ * consumer applying to a PriceFeed), L2 book message throughput,
+ * transient dislocations driven by the timer wheel, full versus
+ * incremental arbitrage scans, pair enumeration versus sorted cross
+ * detection and the cost of a timestamp read.
+ *
+ * Usage: bench_price_feed [threads]
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "price_feed.h"
+#include "tick_arrival_model.h"
+#include "feed_handler.h"
+#include "order_book.h"
+#include "dislocation_engine.h"
+#include "arbitrage_scanner.h"
+#include "tsc_clock.h"
+
+struct BenchCase {
+    const char* label;
+    size_t symbols;
+    size_t venues;
+};
+
+/**
+ * Run update_prices until at least `min_seconds` have elapsed
+ * @param correlated Use the correlated GBM/cointegration model
+ * @return Venue-quote updates per second
+ */
+double bench_update_prices(const BenchCase& bench, size_t threads, bool correlated = false,
+                           double min_seconds = 1.0) {
+    std::vector<Exchange> exchanges;
+    for (size_t v = 0; v < bench.venues; v++) {
+        exchanges.emplace_back("V" + std::to_string(v), "Venue", "City", 0.0, 0.0, ExchangeType::CRYPTO);
+    }
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < bench.symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.0002, 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(exchanges, universe);
+    feed.set_worker_threads(threads);
+    if (correlated) feed.enable_correlated_model(CorrelationParams());
+    feed.update_prices(); // Warm up caches and the thread pool
+    
+    using clock = std::chrono::steady_clock;
+    size_t iterations = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        feed.update_prices();
+        iterations++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    
+    double cells = static_cast<double>(bench.symbols) * bench.venues;
+    return cells * iterations / elapsed;
+}
+
+/**
+ * Drive PriceFeed::apply_tick from a TickArrivalModel for `min_seconds`
+ * @return Tick events per second (arrival sampling + quote update)
+ */
+double bench_tick_events(const BenchCase& bench, const ArrivalParams& params, double min_seconds = 1.0) {
+    std::vector<Exchange> exchanges;
+    for (size_t v = 0; v < bench.venues; v++) {
+        exchanges.emplace_back("V" + std::to_string(v), "Venue", "City", 0.0, 0.0, ExchangeType::CRYPTO);
+    }
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < bench.symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.0002, 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(exchanges, universe);
+    TickArrivalModel model(42);
+    model.initialize(bench.symbols, bench.venues, params);
+    
+    // Advance simulated time in slices of ~100k events
+    double slice = 1e5 / (params.mean_rate() * bench.symbols * bench.venues);
+    
+    using clock = std::chrono::steady_clock;
+    uint64_t events = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        events += model.advance_until(model.now() + slice, [&feed](const TickEvent& event) {
+            feed.apply_tick(event.symbol, event.venue, 0);
+        });
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return events / elapsed;
+}
+
+/**
+ * Publish quotes from the FeedHandler thread as fast as possible while
+ * this thread drains them into a PriceFeed for `min_seconds`
+ * @param conflate Conflate per cell instead of stalling the producer
+ * @param published_rate Receives quotes published per second
+ * @return Quote updates ingested per second
+ */
+double bench_feed_handler(const BenchCase& bench, bool conflate = false, double* published_rate = nullptr,
+                          double min_seconds = 1.0) {
+    std::vector<Exchange> exchanges;
+    for (size_t v = 0; v < bench.venues; v++) {
+        exchanges.emplace_back("V" + std::to_string(v), "Venue", "City", 0.0, 0.0, ExchangeType::CRYPTO);
+    }
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < bench.symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.0002, 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(exchanges, universe);
+    
+    FeedHandler handler;
+    if (conflate) handler.enable_conflation(bench.symbols, bench.venues);
+    uint64_t sequence = 0;
+    handler.start([&](FeedHandler& out) {
+        for (size_t i = 0; i < 1024; i++, sequence++) {
+            double mid = 100.0 + (sequence % 1000) * 0.01;
+            out.apply_quote(static_cast<int>(sequence % bench.symbols),
+                            static_cast<int>((sequence / bench.symbols) % bench.venues),
+                            mid - 0.01, mid + 0.01, 100.0, sequence);
+        }
+        return size_t(1024);
+    });
+    
+    using clock = std::chrono::steady_clock;
+    uint64_t drained = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        size_t n = handler.drain_into(feed);
+        if (n == 0) std::this_thread::yield();
+        drained += n;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    handler.stop();
+    if (published_rate) *published_rate = handler.total_published() / elapsed;
+    return drained / elapsed;
+}
+
+/**
+ * Apply a pre-generated add/modify/delete stream to a store of books
+ * Prices wander within 20 ticks of a per-book mid, so books stay full and
+ * messages hit every level position.
+ * @return Book messages applied per second
+ */
+double bench_order_books(const BenchCase& bench, double min_seconds = 1.0) {
+    const size_t num_messages = 1 << 22;
+    std::vector<BookMessage> messages(num_messages);
+    CounterRng rng(42);
+    for (size_t n = 0; n < num_messages; n++) {
+        auto r = rng.draw(n, 0, 0, 0);
+        BookMessage& msg = messages[n];
+        msg.timestamp = n;
+        msg.symbol = static_cast<uint16_t>(r.v[0] % bench.symbols);
+        msg.venue = static_cast<uint16_t>((r.v[0] / bench.symbols) % bench.venues);
+        msg.side = (r.v[1] & 1) ? BookSide::ASK : BookSide::BID;
+        uint32_t roll = (r.v[1] >> 1) % 10;
+        msg.action = roll < 4 ? BookAction::ADD : (roll < 8 ? BookAction::MODIFY : BookAction::DELETE);
+        Ticks ticks = 1 + r.v[2] % 20;
+        msg.price = 10000 + (msg.side == BookSide::ASK ? ticks : -ticks);
+        msg.size = 1.0 + r.v[3] % 1000;
+    }
+    
+    OrderBookStore books;
+    books.resize(bench.symbols, bench.venues);
+    
+    using clock = std::chrono::steady_clock;
+    uint64_t applied = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        for (const auto& msg : messages) books.apply(msg);
+        applied += num_messages;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return applied / elapsed;
+}
+
+/**
+ * Keep `concurrent` dislocations in flight on simulated feed time, stepping
+ * the engine once per millisecond and topping up as they expire
+ * @return Dislocation wakeups (start, decay step or expiry) per second
+ */
+double bench_dislocations(const BenchCase& bench, size_t concurrent, double min_seconds = 1.0) {
+    std::vector<Exchange> exchanges;
+    for (size_t v = 0; v < bench.venues; v++) {
+        exchanges.emplace_back("V" + std::to_string(v), "Venue", "City", 0.0, 0.0, ExchangeType::CRYPTO);
+    }
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < bench.symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.0002, 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(exchanges, universe);
+    DislocationEngine engine(42);
+    const uint64_t step_ns = engine.get_step_ns();
+    uint64_t t = feed.now_ns();
+    engine.schedule_random(feed, concurrent, t, 0, 0.001, 0.01, 100000000, 1000000000);
+    
+    using clock = std::chrono::steady_clock;
+    uint64_t wakeups = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        for (int k = 0; k < 100; k++) {
+            t += step_ns;
+            wakeups += engine.advance(feed, t);
+            size_t live = engine.active() + engine.pending();
+            if (live < concurrent) {
+                engine.schedule_random(feed, concurrent - live, t, 0, 0.001, 0.01, 100000000, 1000000000);
+            }
+        }
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return wakeups / elapsed;
+}
+
+/**
+ * Scan a feed where `ticks_per_scan` random quotes move between scans
+ * (volatile enough that some venues cross and pairs reach evaluation)
+ * Venues are fully connected up to 1000 of them; larger networks have no
+ * links (every pair unreachable, which costs the same to evaluate)
+ * @param incremental Re-evaluate only pairs of changed venues
+ * @param sorted_crosses Enumerate crossing directions instead of all pairs
+ * @param threads Scanner worker threads
+ * @return Scans per second
+ */
+double bench_scanner(const BenchCase& bench, bool incremental, size_t ticks_per_scan, bool sorted_crosses = true,
+                     size_t threads = 1, double min_seconds = 1.0) {
+    NetworkGraph network;
+    for (size_t v = 0; v < bench.venues; v++) {
+        double latitude = static_cast<double>((v * 37) % 140) - 70.0;
+        double longitude = static_cast<double>((v * 71) % 360) - 180.0;
+        network.add_exchange(Exchange("V" + std::to_string(v), "Venue", "City", latitude, longitude, ExchangeType::CRYPTO));
+    }
+    if (bench.venues <= 1000) network.connect_all_exchanges();
+    std::vector<SymbolSpec> universe;
+    for (size_t s = 0; s < bench.symbols; s++) {
+        universe.emplace_back("S" + std::to_string(s), 100.0 + s, 0.002, 0.01);
+    }
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(network.get_exchanges(), universe);
+    feed.update_prices();
+    ArbitrageScanner scanner(network, feed);
+    scanner.set_opportunity_window(1000.0);
+    scanner.set_sorted_crosses(sorted_crosses);
+    scanner.set_worker_threads(threads);
+    CounterRng rng(7);
+    uint64_t t = feed.now_ns();
+    
+    using clock = std::chrono::steady_clock;
+    size_t scans = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < min_seconds) {
+        for (size_t n = 0; n < ticks_per_scan; n++) {
+            auto r = rng.draw(scans * ticks_per_scan + n, 0, 0, 0);
+            feed.apply_tick(static_cast<int>(r.v[0] % bench.symbols), static_cast<int>(r.v[1] % bench.venues), ++t);
+        }
+        size_t found = incremental ? scanner.scan_opportunities(feed.get_changes())->size()
+                                   : scanner.scan_opportunities().size();
+        (void)found;
+        feed.clear_changes();
+        scans++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return scans / elapsed;
+}
+
+/**
+ * Average cost of one clock read
+ * @return Nanoseconds per read
+ */
+template <typename Clock>
+double bench_clock_read(Clock read, size_t reads = 20000000) {
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < reads; n++) sink += read();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile uint64_t keep = sink;
+    (void)keep;
+    return elapsed * 1e9 / reads;
+}
+
+int main(int argc, char** argv) {
+    size_t threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1;
+    
+    const BenchCase cases[] = {
+        { "1 symbol x 40 venues",       1,     40 },
+        { "2000 symbols x 40 venues",   2000,  40 },
+        { "100 symbols x 1000 venues",  100,   1000 },
+        { "1 symbol x 1M venues",       1,     1000000 },
+    };
+    
+    std::cout << "PriceFeed::update_prices (" << threads << " thread"
+              << (threads == 1 ? "" : "s") << ")" << std::endl;
+    for (const auto& bench : cases) {
+        double rate = bench_update_prices(bench, threads);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " M quote updates/s  ("
+                  << std::setprecision(2) << 1e9 / rate << " ns/quote)" << std::endl;
+    }
+    
+    std::cout << "PriceFeed::update_prices, correlated GBM + jumps + cointegrated venues" << std::endl;
+    const BenchCase correlated_cases[] = {
+        { "100 symbols x 40 venues",    100,   40 },
+        { "2000 symbols x 40 venues",   2000,  40 },
+    };
+    for (const auto& bench : correlated_cases) {
+        auto factor_start = std::chrono::steady_clock::now();
+        CholeskyFactor factor;
+        factor.factor(CorrelationParams().correlation_matrix(bench.symbols), bench.symbols);
+        double factor_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - factor_start).count();
+        
+        double rate = bench_update_prices(bench, threads, true);
+        double update_ms = static_cast<double>(bench.symbols) * bench.venues / rate * 1e3;
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " M quote updates/s  (" << std::setprecision(3) << update_ms
+                  << " ms/update, factor " << std::setprecision(0) << factor_ms << " ms)" << std::endl;
+    }
+    
+    std::cout << "TickArrivalModel + PriceFeed::apply_tick" << std::endl;
+    const BenchCase event_cases[] = {
+        { "12 symbols x 23 venues",     12,    23 },
+        { "2000 symbols x 40 venues",   2000,  40 },
+    };
+    for (const auto& bench : event_cases) {
+        for (int hawkes = 0; hawkes < 2; hawkes++) {
+            ArrivalParams params = hawkes ? ArrivalParams::hawkes(2.0, 8.0, 10.0) : ArrivalParams::poisson(10.0);
+            double rate = bench_tick_events(bench, params);
+            std::cout << "  " << std::left << std::setw(28) << bench.label
+                      << std::setw(8) << (hawkes ? "Hawkes" : "Poisson")
+                      << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                      << rate / 1e6 << " M events/s" << std::endl;
+        }
+    }
+    
+    std::cout << "FeedHandler ring -> PriceFeed::apply_quote" << std::endl;
+    for (const auto& bench : event_cases) {
+        double rate = bench_feed_handler(bench);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " M quotes/s" << std::endl;
+    }
+    
+    std::cout << "FeedHandler with per-cell conflation (applied / published)" << std::endl;
+    for (const auto& bench : event_cases) {
+        double published = 0.0;
+        double rate = bench_feed_handler(bench, true, &published);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " / " << published / 1e6 << " M quotes/s" << std::endl;
+    }
+    
+    std::cout << "OrderBookStore add/modify/delete (" << OrderBook::MAX_LEVELS << " levels)" << std::endl;
+    for (const auto& bench : event_cases) {
+        double rate = bench_order_books(bench);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " M messages/s" << std::endl;
+    }
+    
+    std::cout << "DislocationEngine (1 ms steps, 0.1-1 s lifetimes)" << std::endl;
+    for (size_t concurrent : { 1000, 100000 }) {
+        const BenchCase bench = { "2000 symbols x 40 venues", 2000, 40 };
+        double rate = bench_dislocations(bench, concurrent);
+        std::cout << "  " << std::left << std::setw(28) << (std::to_string(concurrent) + " in flight")
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+                  << rate / 1e6 << " M wakeups/s" << std::endl;
+    }
+    
+    std::cout << "ArbitrageScanner, 2 quotes moved per scan (full / incremental)" << std::endl;
+    const BenchCase scan_cases[] = {
+        { "200 symbols x 40 venues",    200,   40 },
+        { "4 symbols x 600 venues",     4,     600 },
+    };
+    for (const auto& bench : scan_cases) {
+        double full = bench_scanner(bench, false, 2);
+        double incremental = bench_scanner(bench, true, 2);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(8)
+                  << 1e3 / full << " / " << 1e3 / incremental << " ms/scan" << std::endl;
+    }
+    
+    std::cout << "ArbitrageScanner full scan (tiled pair loop / sorted crosses, " << threads << " thread"
+              << (threads == 1 ? "" : "s") << ")" << std::endl;
+    const BenchCase cross_cases[] = {
+        { "200 symbols x 40 venues",    200,   40 },
+        { "4 symbols x 600 venues",     4,     600 },
+        { "1 symbol x 10000 venues",    1,     10000 },
+    };
+    for (const auto& bench : cross_cases) {
+        double pairs = bench_scanner(bench, false, 2, false, threads);
+        double sorted = bench_scanner(bench, false, 2, true, threads);
+        std::cout << "  " << std::left << std::setw(28) << bench.label
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(8)
+                  << 1e3 / pairs << " / " << 1e3 / sorted << " ms/scan" << std::endl;
+    }
+    
+    TscClock::calibrate();
+    std::cout << "Timestamp read (" << (TscClock::uses_tsc() ? "TSC" : "steady_clock fallback") << ")" << std::endl;
+    double tsc_ns = bench_clock_read([] { return TscClock::now_ns(); });
+    double system_ns = bench_clock_read([] {
+        return static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    });
+    std::cout << "  " << std::left << std::setw(28) << "TscClock::now_ns"
+              << std::right << std::fixed << std::setprecision(1) << std::setw(8) << tsc_ns << " ns/read" << std::endl;
+    std::cout << "  " << std::left << std::setw(28) << "system_clock::now"
+              << std::right << std::fixed << std::setprecision(1) << std::setw(8) << system_ns << " ns/read" << std::endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * Local shared-memory quote publisher
+ * Stands in for a multicast feed handler on a single box: quotes are
+ * written into a shared-memory ring (/dev/shm/<name> on Linux) that the
+ * simulator (--shm <name>) or shm_scan consume in place.
+ *
+ * Usage:
+ *   feed_publisher [--name <ring>] [--rate <quotes/s>] [--seconds <s>] [--capacity <slots>]
+ *       Publish the simulated market for the bundled universe at a mean
+ *       total rate (Poisson arrivals); runs until Ctrl-C if --seconds is 0
+ *   feed_publisher [--name <ring>] --replay <file.ticks> [--speed <x> | --max]
+ *       Publish a recorded tick file
+ *
+ * Exchanges and symbols are read from ../data (as the simulator does).
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "exchange.h"
+#include "symbol.h"
+#include "data_loader.h"
+#include "feed_handler.h"
+#include "shm_quote_ring.h"
+#include "tick_replay.h"
+
+std::atomic<bool> g_stop{false};
+
+void handle_signal(int) {
+    g_stop = true;
+}
+
+/**
+ * Print published/dropped counts once per second
+ */
+class RateReporter {
+private:
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+    uint64_t last_published = 0;
+    
+public:
+    void tick(const ShmQuotePublisher& publisher, bool force = false) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - last).count();
+        if (elapsed < 1.0 && !force) return;
+        uint64_t published = publisher.published();
+        std::cout << std::fixed << std::setprecision(0)
+                  << (published - last_published) / elapsed << " quotes/s, "
+                  << published << " published, " << publisher.dropped() << " dropped" << std::endl;
+        last = now;
+        last_published = published;
+    }
+};
+
+int main(int argc, char** argv) {
+    std::string name = "las_quotes";
+    std::string replay_path;
+    double rate = 100000.0;
+    double seconds = 0.0;
+    size_t capacity = ShmQuotePublisher::DEFAULT_CAPACITY;
+    ReplayPace pace = ReplayPace::REAL_TIME;
+    double speed = 1.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc) {
+            name = argv[++i];
+        } else if (arg == "--rate" && i + 1 < argc) {
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--capacity" && i + 1 < argc) {
+            capacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            pace = ReplayPace::ACCELERATED;
+            speed = std::atof(argv[++i]);
+        } else if (arg == "--max") {
+            pace = ReplayPace::AS_FAST_AS_POSSIBLE;
+        } else {
+            std::cerr << "Usage: feed_publisher [--name <ring>] [--rate <quotes/s>] [--seconds <s>] [--capacity <slots>]\n"
+                      << "       feed_publisher [--name <ring>] --replay <file.ticks> [--speed <x> | --max]" << std::endl;
+            return 1;
+        }
+    }
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+    
+    ShmQuotePublisher publisher;
+    RateReporter reporter;
+    auto start = std::chrono::steady_clock::now();
+    auto running = [&]() {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return !g_stop && (seconds <= 0.0 || elapsed < seconds);
+    };
+    
+    if (!replay_path.empty()) {
+        TickReplay replay;
+        if (!replay.open(replay_path)) {
+            std::cerr << "Invalid tick file: " << replay_path << std::endl;
+            return 1;
+        }
+        if (!publisher.create(name, capacity, replay.get_file().symbols(), replay.get_file().venues())) {
+            std::cerr << "Failed to create shared memory ring: " << name << std::endl;
+            return 1;
+        }
+        std::cout << "Publishing " << replay.size() << " ticks from " << replay_path
+                  << " on ring " << name << std::endl;
+        replay.bind_identity();
+        replay.set_pace(pace, speed);
+        replay.start();
+        while (running() && !replay.finished()) {
+            if (replay.pump(publisher) == 0) std::this_thread::yield();
+            reporter.tick(publisher);
+        }
+    } else {
+        std::vector<Exchange> exchanges;
+        if (!load_exchanges("../data/exchanges.json", exchanges)) return 1;
+        std::vector<SymbolSpec> universe;
+        if (!load_symbol_universe("../data/symbols.json", universe)) universe.emplace_back("BTC/USD", 50000.0, 0.0002, 0.01);
+        
+        std::vector<std::string> symbol_names, venue_names;
+        for (const auto& spec : universe) symbol_names.push_back(spec.name);
+        for (const auto& ex : exchanges) venue_names.push_back(ex.id);
+        if (!publisher.create(name, capacity, symbol_names, venue_names)) {
+            std::cerr << "Failed to create shared memory ring: " << name << std::endl;
+            return 1;
+        }
+        
+        double cells = static_cast<double>(universe.size() * exchanges.size());
+        SimulatedFeedSource source(42, exchanges, universe, ArrivalParams::poisson(rate / cells));
+        std::cout << "Publishing " << universe.size() << " symbols x " << exchanges.size()
+                  << " venues at ~" << rate << " quotes/s on ring " << name << std::endl;
+        while (running()) {
+            if (source(publisher) == 0) std::this_thread::yield();
+            reporter.tick(publisher);
+        }
+    }
+    
+    reporter.tick(publisher, true);
+    publisher.close();
+    return 0;
+}
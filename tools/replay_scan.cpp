@@ -0,0 +1,155 @@
+/**
+ * Headless tick replay + arbitrage scan
+ *
+ * Usage:
+ *   replay_scan <file.ticks> [scan_interval_ms]
+ *       Replay a tick file as fast as possible, scanning for arbitrage
+ *       every scan_interval_ms of recorded time (default 100)
+ *   replay_scan record <out.ticks> <seconds> [ticks_per_second]
+ *       Record a synthetic Hawkes tick stream for the bundled universe
+ *
+ * Exchanges and symbols are read from ../data (as the simulator does).
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "network_graph.h"
+#include "data_loader.h"
+#include "price_feed.h"
+#include "arbitrage_scanner.h"
+#include "tick_arrival_model.h"
+#include "tick_file.h"
+#include "tick_replay.h"
+
+/**
+ * Record `seconds` of synthetic Hawkes ticks for every symbol/venue
+ */
+int record(const std::string& path, double seconds, double rate) {
+    NetworkGraph network;
+    if (!load_exchanges("../data/exchanges.json", network)) return 1;
+    network.connect_all_exchanges(TransmissionMedium::FIBER_OPTIC);
+    std::vector<SymbolSpec> universe;
+    if (!load_symbol_universe("../data/symbols.json", universe)) universe.emplace_back("BTC/USD", 50000.0, 0.0002, 0.01);
+    
+    PriceFeed feed(42);
+    feed.initialize_feeds(network.get_exchanges(), universe);
+    TickArrivalModel model(42);
+    model.initialize(feed.num_symbols(), feed.num_venues(), ArrivalParams::hawkes(rate * 0.2, 8.0, 10.0));
+    
+    std::vector<std::string> symbol_names, venue_names;
+    for (size_t s = 0; s < feed.num_symbols(); s++) symbol_names.push_back(feed.get_symbol(s).name);
+    for (size_t v = 0; v < feed.num_venues(); v++) venue_names.push_back(feed.get_venue_id(v));
+    
+    TickFileWriter writer;
+    if (!writer.open(path, symbol_names, venue_names)) {
+        std::cerr << "Failed to create: " << path << std::endl;
+        return 1;
+    }
+    
+    uint64_t start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    model.advance_until(seconds, [&](const TickEvent& event) {
+        uint64_t ts_ns = start_ns + static_cast<uint64_t>(event.time * 1e9);
+        feed.apply_tick(event.symbol, event.venue, ts_ns);
+        
+        const QuoteStore& quotes = feed.get_quotes();
+        size_t i = quotes.index(event.symbol, event.venue);
+        TickRecord r;
+        r.timestamp_ns = ts_ns;
+        r.symbol = static_cast<uint16_t>(event.symbol);
+        r.venue = static_cast<uint16_t>(event.venue);
+        r.volume = static_cast<float>(quotes.volume[i]);
+        r.bid = quotes.bid[i] * quotes.tick_size[event.symbol];
+        r.ask = quotes.ask[i] * quotes.tick_size[event.symbol];
+        writer.write(r);
+    });
+    
+    if (!writer.finish()) {
+        std::cerr << "Failed to write: " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Recorded " << writer.records_written() << " ticks to " << path << std::endl;
+    return 0;
+}
+
+/**
+ * Replay a file at full speed and scan every `interval_ms` of recorded time
+ */
+int replay(const std::string& path, double interval_ms) {
+    NetworkGraph network;
+    if (!load_exchanges("../data/exchanges.json", network)) return 1;
+    network.connect_all_exchanges(TransmissionMedium::FIBER_OPTIC);
+    
+    TickReplay source;
+    if (!source.open(path)) {
+        std::cerr << "Invalid tick file: " << path << std::endl;
+        return 1;
+    }
+    
+    // Quote exactly the symbols in the recording, on their known tick grids
+    std::vector<SymbolSpec> known;
+    load_symbol_universe("../data/symbols.json", known);
+    std::vector<SymbolSpec> universe;
+    for (const auto& name : source.get_file().symbols()) {
+        universe.push_back(SymbolSpec::external(name, known));
+    }
+    PriceFeed feed(0);
+    feed.initialize_feeds(network.get_exchanges(), universe);
+    source.bind(feed);
+    source.set_pace(ReplayPace::AS_FAST_AS_POSSIBLE);
+    source.start();
+    
+    ArbitrageScanner scanner(network, feed);
+    uint64_t step_ns = static_cast<uint64_t>(interval_ms * 1e6);
+    uint64_t next_scan_ns = source.get_file().first_timestamp_ns() + step_ns;
+    size_t scans = 0, unchanged = 0, opportunities = 0;
+    size_t last_opportunities = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    while (!source.finished()) {
+        // Intervals whose ticks left every quote unchanged keep the last result;
+        // otherwise only pairs with a changed venue are compared again
+        source.replay_until(feed, next_scan_ns);
+        if (feed.get_changes().any()) {
+            last_opportunities = scanner.scan_opportunities(feed.get_changes())->size();
+            feed.clear_changes();
+            scans++;
+        } else {
+            unchanged++;
+        }
+        opportunities += last_opportunities;
+        
+        // Skip empty intervals (gaps in the recording)
+        next_scan_ns += step_ns;
+        if (!source.finished() && source.get_file()[source.position()].timestamp_ns > next_scan_ns) {
+            uint64_t gap = source.get_file()[source.position()].timestamp_ns - next_scan_ns;
+            next_scan_ns += (gap / step_ns + 1) * step_ns;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    double recorded_s = (source.get_file().last_timestamp_ns() - source.get_file().first_timestamp_ns()) / 1e9;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Replayed " << source.records_applied() << " ticks (" << source.records_skipped()
+              << " skipped), " << recorded_s << " s recorded, in " << elapsed << " s\n"
+              << "  " << source.size() / elapsed / 1e6 << " M ticks/s, "
+              << scans << " scans (" << unchanged << " unchanged intervals), "
+              << opportunities << " opportunities" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && std::string(argv[1]) == "record") {
+        double rate = (argc > 4) ? std::atof(argv[4]) : 10.0;
+        return record(argv[2], std::atof(argv[3]), rate);
+    }
+    if (argc >= 2) {
+        return replay(argv[1], (argc > 2) ? std::atof(argv[2]) : 100.0);
+    }
+    std::cerr << "Usage: replay_scan <file.ticks> [scan_interval_ms]\n"
+              << "       replay_scan record <out.ticks> <seconds> [ticks_per_second]" << std::endl;
+    return 1;
+}
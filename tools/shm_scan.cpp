@@ -0,0 +1,118 @@
+/**
+ * Shared-memory feed consumer + arbitrage scan
+ * Attaches to a feed_publisher ring, applies quotes to a PriceFeed in
+ * place and scans after every batch, reporting cross-process
+ * tick-to-signal latency: publish time of the oldest quote in a batch to
+ * the end of the scan that saw it.
+ *
+ * Usage: shm_scan [ring] [seconds]
+ *
+ * Exchanges are read from ../data (as the simulator does).
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "network_graph.h"
+#include "data_loader.h"
+#include "price_feed.h"
+#include "arbitrage_scanner.h"
+#include "shm_quote_ring.h"
+
+/**
+ * Print latency percentiles (microseconds) of the samples and clear them
+ */
+void report(std::vector<uint64_t>& latencies_ns, uint64_t quotes, uint64_t scans, double elapsed,
+            uint64_t dropped) {
+    std::cout << std::fixed << std::setprecision(0) << quotes / elapsed << " quotes/s, "
+              << scans / elapsed << " scans/s, " << dropped << " dropped";
+    if (!latencies_ns.empty()) {
+        std::sort(latencies_ns.begin(), latencies_ns.end());
+        auto pct = [&](double p) {
+            return latencies_ns[std::min(latencies_ns.size() - 1, static_cast<size_t>(p * latencies_ns.size()))] / 1e3;
+        };
+        std::cout << std::setprecision(1) << "  tick-to-signal p50 " << pct(0.50) << " us, p99 "
+                  << pct(0.99) << " us, max " << latencies_ns.back() / 1e3 << " us";
+    }
+    std::cout << std::endl;
+    latencies_ns.clear();
+}
+
+int main(int argc, char** argv) {
+    std::string name = (argc > 1) ? argv[1] : "las_quotes";
+    double seconds = (argc > 2) ? std::atof(argv[2]) : 0.0;
+    
+    NetworkGraph network;
+    if (!load_exchanges("../data/exchanges.json", network)) return 1;
+    network.connect_all_exchanges(TransmissionMedium::FIBER_OPTIC);
+    
+    // Wait up to 10 s for the publisher to create the ring
+    ShmQuoteConsumer ring;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!ring.open(name)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::cerr << "No shared-memory feed named " << name << " (start feed_publisher first)" << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    
+    // Quote exactly the publisher's symbols
+    std::vector<SymbolSpec> universe;
+    for (const auto& symbol : ring.symbols()) {
+        universe.push_back(SymbolSpec::external(symbol));
+    }
+    PriceFeed feed(0);
+    feed.initialize_feeds(network.get_exchanges(), universe);
+    ring.bind(feed);
+    ArbitrageScanner scanner(network, feed);
+    std::cout << "Attached to " << name << " (" << ring.symbols().size() << " symbols x "
+              << ring.venues().size() << " venues, " << ring.capacity() << " slots)" << std::endl;
+    
+    std::vector<uint64_t> latencies_ns;
+    uint64_t quotes = 0, scans = 0, total_quotes = 0, total_scans = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto window_start = start;
+    while (!ring.finished()) {
+        auto now = std::chrono::steady_clock::now();
+        if (seconds > 0.0 && std::chrono::duration<double>(now - start).count() >= seconds) break;
+        
+        size_t n = ring.drain_into(feed);
+        feed.refresh_venue_health();   // Venues with dropped quotes sit out of scans for a while
+        if (n > 0) {
+            // Batches that only repeat current quotes need no scan; the rest
+            // re-evaluate just the pairs of the venues they moved
+            if (feed.get_changes().any()) {
+                scanner.scan_opportunities(feed.get_changes());
+                feed.clear_changes();
+                scans++;
+            }
+            latencies_ns.push_back(monotonic_ns() - ring.last_batch_oldest_send_ns());
+            quotes += n;
+        } else {
+            std::this_thread::yield();
+        }
+        
+        double window = std::chrono::duration<double>(now - window_start).count();
+        if (window >= 1.0) {
+            report(latencies_ns, quotes, scans, window, ring.publisher_dropped());
+            total_quotes += quotes;
+            total_scans += scans;
+            quotes = scans = 0;
+            window_start = now;
+        }
+    }
+    total_quotes += quotes;
+    total_scans += scans;
+    
+    std::cout << "Consumed " << total_quotes << " quotes (" << ring.quotes_skipped() << " skipped) in "
+              << total_scans << " scans" << std::endl;
+    const VenueHealth& health = feed.get_venue_health();
+    std::cout << "Sequence gaps: " << health.total_gaps() << " (" << health.total_missed() << " quotes missed, "
+              << health.total_duplicates() << " duplicates)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * CSV -> binary tick file converter
+ * Reads vendor dumps with exchange, symbol, timestamp, bid, ask and size
+ * columns (header optional; default column order as listed) and writes a
+ * tick file the simulator can replay with --replay.
+ *
+ * The input is mmap'd and converted in windows: each window is split at
+ * line boundaries into one chunk per thread, chunks are parsed in
+ * parallel, then their local symbol/venue ids are remapped to the global
+ * tables and the window is appended to the output in input order.
+ *
+ * Usage: tick_import <in.csv> <out.ticks> [threads]
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include "mapped_file.h"
+#include "tick_file.h"
+#include "csv_tick_parser.h"
+#include "thread_pool.h"
+
+// Input bytes parsed per thread per window (bounds memory use)
+constexpr size_t WINDOW_BYTES_PER_THREAD = 64 << 20;
+
+/**
+ * Global name table built from chunk-local dictionaries in input order
+ */
+struct NameTable {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint16_t> ids;
+    
+    /**
+     * Map local ids to global ids
+     * @return false if the table would exceed 65536 names
+     */
+    bool remap(const std::vector<std::string_view>& local, std::vector<uint16_t>& mapping) {
+        mapping.resize(local.size());
+        for (size_t i = 0; i < local.size(); i++) {
+            std::string name(local[i]);
+            auto it = ids.find(name);
+            if (it == ids.end()) {
+                if (names.size() > UINT16_MAX) return false;
+                it = ids.emplace(name, static_cast<uint16_t>(names.size())).first;
+                names.push_back(name);
+            }
+            mapping[i] = it->second;
+        }
+        return true;
+    }
+};
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: tick_import <in.csv> <out.ticks> [threads]" << std::endl;
+        return 1;
+    }
+    std::string in_path = argv[1];
+    std::string out_path = argv[2];
+    size_t threads = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+    threads = std::max<size_t>(1, threads);
+    
+    MappedFile input;
+    if (!input.open(in_path)) {
+        std::cerr << "Failed to open: " << in_path << std::endl;
+        return 1;
+    }
+    input.advise_sequential();
+    const char* data = input.data();
+    size_t size = input.size();
+    
+    // Optional header line selects the column layout
+    CsvTickColumns columns;
+    size_t pos = 0;
+    const char* newline = static_cast<const char*>(std::memchr(data, '\n', size));
+    size_t first_line = newline ? static_cast<size_t>(newline - data) : size;
+    if (columns.from_header(std::string_view(data, first_line))) {
+        pos = newline ? first_line + 1 : size;
+    }
+    
+    TickFileWriter writer;
+    if (!writer.open(out_path)) {
+        std::cerr << "Failed to create: " << out_path << std::endl;
+        return 1;
+    }
+    
+    ThreadPool pool(threads);
+    std::vector<CsvChunkResult> chunks(threads);
+    std::vector<size_t> bounds(threads + 1);
+    std::vector<std::vector<uint16_t>> symbol_maps(threads), venue_maps(threads);
+    std::vector<TickRecord> window_records;
+    NameTable symbols, venues;
+    uint64_t lines = 0, bad_lines = 0;
+    bool ordered = true;
+    
+    auto start = std::chrono::steady_clock::now();
+    while (pos < size) {
+        size_t window_end = CsvTickParser::align_to_line(data, size, std::min(size, pos + WINDOW_BYTES_PER_THREAD * threads));
+        for (size_t c = 0; c <= threads; c++) {
+            size_t target = pos + ThreadPool::chunk_begin(window_end - pos, threads, c);
+            bounds[c] = (c == threads) ? window_end : CsvTickParser::align_to_line(data, window_end, target);
+        }
+        
+        // Parse chunks in parallel
+        pool.parallel_for(threads, threads, [&](size_t, size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                chunks[c].clear();
+                chunks[c].records.reserve((bounds[c + 1] - bounds[c]) / 48);
+                CsvTickParser::parse_chunk(data + bounds[c], data + bounds[c + 1], columns, chunks[c]);
+            }
+        });
+        
+        // Global ids are assigned in input order, so the tables are deterministic
+        for (size_t c = 0; c < threads; c++) {
+            if (!symbols.remap(chunks[c].symbols, symbol_maps[c]) || !venues.remap(chunks[c].venues, venue_maps[c])) {
+                std::cerr << "Too many distinct symbols or venues (max 65536)" << std::endl;
+                return 1;
+            }
+            lines += chunks[c].lines;
+            bad_lines += chunks[c].bad_lines;
+        }
+        
+        pool.parallel_for(threads, threads, [&](size_t, size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) {
+                for (auto& r : chunks[c].records) {
+                    r.symbol = symbol_maps[c][r.symbol];
+                    r.venue = venue_maps[c][r.venue];
+                }
+            }
+        });
+        
+        // Concatenate in input order; fix local reordering within the window
+        window_records.clear();
+        for (const auto& chunk : chunks) {
+            window_records.insert(window_records.end(), chunk.records.begin(), chunk.records.end());
+        }
+        auto by_time = [](const TickRecord& a, const TickRecord& b) { return a.timestamp_ns < b.timestamp_ns; };
+        if (!std::is_sorted(window_records.begin(), window_records.end(), by_time)) {
+            std::stable_sort(window_records.begin(), window_records.end(), by_time);
+        }
+        if (!window_records.empty() && writer.records_written() > 0 &&
+            window_records.front().timestamp_ns < writer.last_timestamp_ns()) {
+            ordered = false;
+        }
+        writer.write(window_records.data(), window_records.size());
+        
+        pos = window_end;
+    }
+    
+    writer.set_tables(symbols.names, venues.names);
+    bool written = writer.finish();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    if (!ordered) {
+        std::cerr << "Input is not time-ordered across " << (WINDOW_BYTES_PER_THREAD * threads >> 20)
+                  << " MB windows; sort it by timestamp first" << std::endl;
+        std::remove(out_path.c_str());
+        return 1;
+    }
+    if (!written) {
+        std::cerr << "Failed to write: " << out_path << std::endl;
+        return 1;
+    }
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << "Imported " << writer.records_written() << " ticks (" << bad_lines << " of " << lines
+              << " lines rejected), " << symbols.names.size() << " symbols x " << venues.names.size()
+              << " venues\n"
+              << "  " << size / elapsed / 1e6 << " MB/s, " << writer.records_written() / elapsed / 1e6
+              << " M ticks/s on " << threads << " thread" << (threads == 1 ? "" : "s") << std::endl;
+    return 0;
+}